@@ -0,0 +1,85 @@
+// app/bench/AuthBench.cc
+// Measures the per-request cost of authentication: Argon2id hashing and
+// verification in PasswordUtils, and JWT signing and verification in JwtService.
+#include "comfyui_plus_backend/services/JwtService.h"
+#include "comfyui_plus_backend/utils/PasswordUtils.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace cupb_services = comfyui_plus_backend::app::services;
+namespace cupb_utils = comfyui_plus_backend::app::utils;
+
+namespace
+{
+
+const std::string kPassword = "correct horse battery staple";
+
+void BM_PasswordUtils_Hash(benchmark::State &state)
+{
+    for (auto _ : state) {
+        std::string hash = cupb_utils::PasswordUtils::hashPassword(kPassword);
+        if (hash.empty()) {
+            state.SkipWithError("hashPassword failed");
+            break;
+        }
+        benchmark::DoNotOptimize(hash.data());
+    }
+}
+
+void BM_PasswordUtils_Verify(benchmark::State &state)
+{
+    const std::string hash = cupb_utils::PasswordUtils::hashPassword(kPassword);
+    for (auto _ : state) {
+        bool ok = cupb_utils::PasswordUtils::verifyPassword(kPassword, hash);
+        if (!ok) {
+            state.SkipWithError("verifyPassword rejected its own hash");
+            break;
+        }
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
+void BM_JwtService_GenerateToken(benchmark::State &state)
+{
+    cupb_services::JwtService jwtService;
+    for (auto _ : state) {
+        std::string token = jwtService.generateToken(42, "bench-user");
+        benchmark::DoNotOptimize(token.data());
+    }
+}
+
+// The path JwtAuthFilter runs for every protected request
+void BM_JwtService_VerifyToken(benchmark::State &state)
+{
+    cupb_services::JwtService jwtService;
+    const std::string token = jwtService.generateToken(42, "bench-user");
+    for (auto _ : state) {
+        auto decoded = jwtService.verifyToken(token);
+        if (!decoded) {
+            state.SkipWithError("verifyToken rejected a fresh token");
+            break;
+        }
+        benchmark::DoNotOptimize(jwtService.getUserIdFromToken(*decoded));
+    }
+}
+
+// A token whose signature does not match is decoded before it is rejected
+void BM_JwtService_VerifyToken_BadSignature(benchmark::State &state)
+{
+    cupb_services::JwtService jwtService;
+    std::string token = jwtService.generateToken(42, "bench-user");
+    token.back() = token.back() == 'A' ? 'B' : 'A';
+    for (auto _ : state) {
+        auto decoded = jwtService.verifyToken(token);
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+
+} // namespace
+
+// Each hash allocates 64 MiB (PasswordUtils::M_COST)
+BENCHMARK(BM_PasswordUtils_Hash)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PasswordUtils_Verify)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JwtService_GenerateToken)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_JwtService_VerifyToken)->Unit(benchmark::kMicrosecond)->ThreadRange(1, 8);
+BENCHMARK(BM_JwtService_VerifyToken_BadSignature)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,49 @@
+// app/bench/BenchMain.cc
+#include <benchmark/benchmark.h>
+#include <json/json.h>
+#include <trantor/utils/Logger.h>
+
+// Read by the services under benchmark in place of main.cc's config
+Json::Value globalJwtConfig;
+Json::Value globalUsersConfig;
+Json::Value globalTracingConfig;
+
+namespace comfyui_plus_backend
+{
+namespace bench
+{
+void registerWorkflowIngestFileBenchmarks();
+void registerWorkflowGraphFileBenchmarks();
+void registerUserServiceBenchmarks();
+} // namespace bench
+} // namespace comfyui_plus_backend
+
+int main(int argc, char **argv)
+{
+    trantor::Logger::setLogLevel(trantor::Logger::kWarn);
+
+    globalJwtConfig["secret"] = "benchmark-secret-benchmark-secret-benchmark";
+    globalJwtConfig["issuer"] = "comfyui-plus";
+    globalJwtConfig["audience"] = "web-app";
+    globalJwtConfig["expires_in_seconds"] = 3600;
+    globalTracingConfig["enabled"] = false;
+
+    // Benchmarks over real workflows are registered at runtime, see BenchWorkflows.h
+    comfyui_plus_backend::bench::registerWorkflowIngestFileBenchmarks();
+    comfyui_plus_backend::bench::registerWorkflowGraphFileBenchmarks();
+    // Database benchmarks are sized by $COMFYUI_BENCH_USER_ROWS, see UserServiceBench.cc
+    comfyui_plus_backend::bench::registerUserServiceBenchmarks();
+
+#ifdef COMFYUI_PLUS_GIT_COMMIT
+    // Recorded in --benchmark_out JSON so that two result files name their commits
+    benchmark::AddCustomContext("git_commit", COMFYUI_PLUS_GIT_COMMIT);
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,83 @@
+// app/bench/BenchWorkflows.h
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace bench
+{
+
+// Builds a ComfyUI UI-format workflow with nodeCount nodes chained by links.
+// Nodes carry positions, widget values and a prompt string so that the
+// bytes-per-node ratio is close to real editor exports (~1-2 KB per node).
+inline std::string makeSyntheticWorkflow(size_t nodeCount)
+{
+    static const char *kTypes[] = {"CheckpointLoaderSimple", "CLIPTextEncode", "KSampler",
+                                   "VAEDecode", "SaveImage", "EmptyLatentImage", "LoraLoader"};
+    const std::string prompt(600, 'a');
+
+    std::ostringstream out;
+    out << "{\"last_node_id\":" << nodeCount << ",\"last_link_id\":" << (nodeCount ? nodeCount - 1 : 0)
+        << ",\"nodes\":[";
+    for (size_t i = 1; i <= nodeCount; ++i) {
+        const char *type = kTypes[i % (sizeof(kTypes) / sizeof(kTypes[0]))];
+        if (i > 1) {
+            out << ',';
+        }
+        out << "{\"id\":" << i << ",\"type\":\"" << type << "\",\"pos\":[" << (i % 100) * 350 << ','
+            << (i / 100) * 300 << "],\"size\":[315,262],\"flags\":{},\"order\":" << i
+            << ",\"mode\":0,\"color\":\"#322\",\"bgcolor\":\"#533\",\"inputs\":[{\"name\":\"model\",\"type\":\"MODEL\",\"link\":"
+            << (i > 1 ? std::to_string(i - 1) : "null")
+            << "}],\"outputs\":[{\"name\":\"MODEL\",\"type\":\"MODEL\",\"links\":["
+            << (i < nodeCount ? std::to_string(i) : "")
+            << "],\"slot_index\":0}],\"properties\":{\"Node name for S&R\":\"" << type
+            << "\"},\"widgets_values\":[" << i * 7919 << ",\"randomize\",20,8,\"euler\",\"normal\",1,\""
+            << prompt << "\"]}";
+    }
+    out << "],\"links\":[";
+    for (size_t i = 1; i < nodeCount; ++i) {
+        if (i > 1) {
+            out << ',';
+        }
+        out << '[' << i << ',' << i << ",0," << i + 1 << ",0,\"MODEL\"]";
+    }
+    out << "],\"groups\":[],\"config\":{},\"extra\":{\"ds\":{\"scale\":1,\"offset\":[0,0]}},\"version\":0.4}";
+    return out.str();
+}
+
+// Wraps a graph in the POST /workflows envelope
+inline std::string makeUploadBody(const std::string &graph)
+{
+    return "{\"name\":\"bench\",\"description\":\"benchmark workflow\",\"is_public\":false,\"json_data\":" +
+           graph + "}";
+}
+
+// Loads every *.json file from $COMFYUI_BENCH_WORKFLOW_DIR so benchmarks can run
+// against real exported workflows. Returns (file name, contents) pairs.
+inline std::vector<std::pair<std::string, std::string>> loadWorkflowFiles()
+{
+    std::vector<std::pair<std::string, std::string>> files;
+    const char *dir = std::getenv("COMFYUI_BENCH_WORKFLOW_DIR");
+    if (!dir || !std::filesystem::is_directory(dir)) {
+        return files;
+    }
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") {
+            continue;
+        }
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        files.emplace_back(entry.path().filename().string(), std::move(contents));
+    }
+    return files;
+}
+
+} // namespace bench
+} // namespace comfyui_plus_backend
@@ -0,0 +1,54 @@
+// app/bench/PromptConverterBench.cc
+// Measures UI-workflow to API-prompt conversion, the work a prompt cache hit skips.
+#include "BenchWorkflows.h"
+#include "comfyui_plus_backend/graph/PromptConverter.h"
+#include <benchmark/benchmark.h>
+
+namespace cupb_bench = comfyui_plus_backend::bench;
+namespace cupb_graph = comfyui_plus_backend::app::graph;
+
+namespace
+{
+
+// Widget layout matching the widgets_values written by makeSyntheticWorkflow()
+const cupb_graph::NodeSchemaRegistry &syntheticSchemas()
+{
+    static const cupb_graph::NodeSchemaRegistry registry = [] {
+        static const char *kTypes[] = {"CheckpointLoaderSimple", "CLIPTextEncode", "KSampler",
+                                       "VAEDecode", "SaveImage", "EmptyLatentImage", "LoraLoader"};
+        std::string objectInfo = "{";
+        for (const char *type : kTypes) {
+            if (objectInfo.size() > 1) {
+                objectInfo += ',';
+            }
+            objectInfo += std::string("\"") + type +
+                          "\":{\"input\":{\"required\":{\"model\":[\"MODEL\"],"
+                          "\"seed\":[\"INT\",{\"control_after_generate\":true}],\"steps\":[\"INT\",{}],"
+                          "\"cfg\":[\"FLOAT\",{}],\"sampler_name\":[[\"euler\"],{}],\"scheduler\":[[\"normal\"],{}],"
+                          "\"denoise\":[\"FLOAT\",{}],\"text\":[\"STRING\",{\"multiline\":true}]}}}";
+        }
+        objectInfo += '}';
+        auto parsed = cupb_graph::NodeSchemaRegistry::fromObjectInfo(objectInfo);
+        return parsed ? std::move(*parsed) : cupb_graph::NodeSchemaRegistry();
+    }();
+    return registry;
+}
+
+void BM_PromptConverter_Convert(benchmark::State &state)
+{
+    std::string graph = cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0)));
+    cupb_graph::PromptConverter converter(syntheticSchemas());
+    for (auto _ : state) {
+        auto prompt = converter.convert(graph);
+        if (!prompt) {
+            state.SkipWithError(prompt.error().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(prompt->size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * graph.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_PromptConverter_Convert)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
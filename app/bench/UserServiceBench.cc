@@ -0,0 +1,203 @@
+// app/bench/UserServiceBench.cc
+// Measures UserService lookups against a temporary SQLite file seeded with
+// $COMFYUI_BENCH_USER_ROWS users (default 10000), with and without UserCache.
+#include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/services/UserCache.h"
+#include "comfyui_plus_backend/services/UserService.h"
+#include "comfyui_plus_backend/utils/PasswordUtils.h"
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace cupb_db = comfyui_plus_backend::app::db;
+namespace cupb_services = comfyui_plus_backend::app::services;
+namespace cupb_utils = comfyui_plus_backend::app::utils;
+
+namespace
+{
+
+std::string username(int64_t id)
+{
+    return "bench_user_" + std::to_string(id);
+}
+
+std::string email(int64_t id)
+{
+    return "bench_user_" + std::to_string(id) + "@example.com";
+}
+
+// The database the benchmarks share; created on first use, deleted at exit
+class BenchDatabase
+{
+public:
+    static BenchDatabase &get()
+    {
+        static BenchDatabase database;
+        return database;
+    }
+
+    int64_t rows() const { return rows_; }
+
+    // $COMFYUI_BENCH_USER_ROWS, or 10000
+    static int64_t rowCount()
+    {
+        const char *rows = std::getenv("COMFYUI_BENCH_USER_ROWS");
+        if (rows) {
+            char *end = nullptr;
+            long long parsed = std::strtoll(rows, &end, 10);
+            if (end != rows && *end == '\0' && parsed > 0) {
+                return parsed;
+            }
+        }
+        return 10000;
+    }
+
+    ~BenchDatabase()
+    {
+        std::error_code ignored;
+        for (const char *suffix : {"", "-wal", "-shm"}) {
+            std::filesystem::remove(path_ + suffix, ignored);
+        }
+    }
+
+private:
+    BenchDatabase()
+        : rows_(rowCount()),
+          path_((std::filesystem::temp_directory_path() /
+                 ("comfyui_plus_bench_" + std::to_string(::getpid()) + ".sqlite")).string())
+    {
+        auto &dbManager = cupb_db::DatabaseManager::getInstance();
+        if (!dbManager.initialize(path_)) {
+            throw std::runtime_error("Cannot create benchmark database at " + path_);
+        }
+
+        // Every row shares one real hash; hashing each would take minutes
+        const std::string hashedPassword = cupb_utils::PasswordUtils::hashPassword("bench-password");
+        const int64_t timestamp = 1700000000000000;
+
+        auto &storage = dbManager.getStorage();
+        auto guard = storage.transaction_guard();
+        for (int64_t id = 1; id <= rows_; ++id) {
+            cupb_db::models::User user;
+            user.username = username(id);
+            user.email = email(id);
+            user.hashedPassword = hashedPassword;
+            user.createdAt = timestamp;
+            user.updatedAt = timestamp;
+            storage.insert(user);
+        }
+        guard.commit();
+
+        cupb_services::UserService().loadExistenceFilter();
+    }
+
+    int64_t rows_;
+    std::string path_;
+};
+
+// Runs `lookup` with ids spread over the table; threads take turns through
+// the ids so that concurrent lookups hit different rows. The first run seeds
+// the database before its timed loop starts.
+void runLookups(benchmark::State &state, const std::function<bool(cupb_services::UserService &, int64_t)> &lookup)
+{
+    const int64_t rows = BenchDatabase::get().rows();
+    cupb_db::DatabaseManager::getInstance().warmUpConnection();
+    cupb_services::UserService userService;
+
+    int64_t next = state.thread_index();
+    for (auto _ : state) {
+        const int64_t id = next % rows + 1;
+        next += state.threads();
+        if (!lookup(userService, id)) {
+            state.SkipWithError(("Lookup failed for user " + std::to_string(id)).c_str());
+            break;
+        }
+    }
+    state.counters["rows"] = static_cast<double>(rows);
+}
+
+void BM_UserService_GetUserById_Cached(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t) {
+        // One user, so every call after the first is a cache hit
+        return userService.getUserById(1).has_value();
+    });
+}
+
+// Invalidating first sends every lookup to SQLite; the invalidation itself
+// is a shard lock and a hash erase, small next to the query
+void BM_UserService_GetUserById_Uncached(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t id) {
+        cupb_services::UserCache::getInstance().invalidate(id);
+        return userService.getUserById(id).has_value();
+    });
+}
+
+void BM_UserService_GetUserByUsername_Uncached(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t id) {
+        const std::string name = username(id);
+        cupb_services::UserCache::getInstance().invalidateNames(name, email(id));
+        return userService.getUserByUsername(name).has_value();
+    });
+}
+
+// Login by username: the email lookup misses before the username one hits
+void BM_UserService_GetHashedPasswordForLogin(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t id) {
+        return userService.getHashedPasswordForLogin(username(id)).has_value();
+    });
+}
+
+// Registration with unused names: UserExistenceFilter answers without a query
+void BM_UserService_UserExists_NewNames(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t id) {
+        return !userService.userExists("new_" + username(id), "new_" + email(id));
+    });
+}
+
+// Registration with a taken username: the filter passes it on to SQLite
+void BM_UserService_UserExists_Taken(benchmark::State &state)
+{
+    runLookups(state, [](cupb_services::UserService &userService, int64_t id) {
+        return userService.userExists(username(id), email(id));
+    });
+}
+
+} // namespace
+
+namespace comfyui_plus_backend
+{
+namespace bench
+{
+
+// Registers the lookups for the configured row count. Each thread queries
+// through its own connection, as the I/O loops and DB workers do.
+void registerUserServiceBenchmarks()
+{
+    const std::string rows = std::to_string(BenchDatabase::rowCount());
+    benchmark::AddCustomContext("user_rows", rows);
+
+    auto add = [&rows](const char *name, void (*fn)(benchmark::State &)) {
+        benchmark::RegisterBenchmark((std::string(name) + "/rows:" + rows).c_str(), fn)
+            ->Unit(benchmark::kMicrosecond)
+            ->ThreadRange(1, 8)
+            ->UseRealTime();
+    };
+    add("BM_UserService_GetUserById_Cached", BM_UserService_GetUserById_Cached);
+    add("BM_UserService_GetUserById_Uncached", BM_UserService_GetUserById_Uncached);
+    add("BM_UserService_GetUserByUsername_Uncached", BM_UserService_GetUserByUsername_Uncached);
+    add("BM_UserService_GetHashedPasswordForLogin", BM_UserService_GetHashedPasswordForLogin);
+    add("BM_UserService_UserExists_NewNames", BM_UserService_UserExists_NewNames);
+    add("BM_UserService_UserExists_Taken", BM_UserService_UserExists_Taken);
+}
+
+} // namespace bench
+} // namespace comfyui_plus_backend
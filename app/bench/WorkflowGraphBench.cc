@@ -0,0 +1,93 @@
+// app/bench/WorkflowGraphBench.cc
+// Measures CSR graph construction and analysis (topological order, cycles,
+// dangling links, type counts) over synthetic and real workflows.
+#include "BenchWorkflows.h"
+#include "comfyui_plus_backend/graph/WorkflowGraph.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace cupb_bench = comfyui_plus_backend::bench;
+namespace cupb_graph = comfyui_plus_backend::app::graph;
+
+namespace
+{
+
+void runGraphParse(benchmark::State &state, const std::string &graph)
+{
+    for (auto _ : state) {
+        auto parsed = cupb_graph::WorkflowGraph::parse(graph);
+        if (!parsed) {
+            state.SkipWithError(parsed.error().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(parsed->edgeCount());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * graph.size()));
+}
+
+void runGraphParseAndAnalyze(benchmark::State &state, const std::string &graph)
+{
+    for (auto _ : state) {
+        auto parsed = cupb_graph::WorkflowGraph::parse(graph);
+        if (!parsed) {
+            state.SkipWithError(parsed.error().c_str());
+            break;
+        }
+        auto analysis = cupb_graph::analyzeGraph(*parsed);
+        benchmark::DoNotOptimize(analysis.topologicalOrder.size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * graph.size()));
+}
+
+void BM_WorkflowGraph_Parse(benchmark::State &state)
+{
+    std::string graph = cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0)));
+    runGraphParse(state, graph);
+}
+
+void BM_WorkflowGraph_ParseAndAnalyze(benchmark::State &state)
+{
+    std::string graph = cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0)));
+    runGraphParseAndAnalyze(state, graph);
+}
+
+// Analysis alone, i.e. what a cache hit saves beyond the parse
+void BM_WorkflowGraph_Analyze(benchmark::State &state)
+{
+    auto parsed = cupb_graph::WorkflowGraph::parse(
+        cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0))));
+    if (!parsed) {
+        state.SkipWithError(parsed.error().c_str());
+        return;
+    }
+    for (auto _ : state) {
+        auto analysis = cupb_graph::analyzeGraph(*parsed);
+        benchmark::DoNotOptimize(analysis.topologicalOrder.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * parsed->nodeCount()));
+}
+
+} // namespace
+
+BENCHMARK(BM_WorkflowGraph_Parse)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorkflowGraph_ParseAndAnalyze)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorkflowGraph_Analyze)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+namespace comfyui_plus_backend
+{
+namespace bench
+{
+
+// Registers graph benchmarks for each real workflow found by loadWorkflowFiles()
+void registerWorkflowGraphFileBenchmarks()
+{
+    for (auto &[name, contents] : loadWorkflowFiles()) {
+        auto graph = std::make_shared<std::string>(std::move(contents));
+        benchmark::RegisterBenchmark(("BM_WorkflowGraph_ParseAndAnalyze/file:" + name).c_str(),
+                                     [graph](benchmark::State &state) { runGraphParseAndAnalyze(state, *graph); })
+            ->Unit(benchmark::kMillisecond);
+    }
+}
+
+} // namespace bench
+} // namespace comfyui_plus_backend
@@ -0,0 +1,87 @@
+// app/bench/WorkflowIngestBench.cc
+// Compares the simdjson On-Demand ingest path against the jsoncpp DOM parse
+// that req->getJsonObject() used to perform on every workflow upload.
+#include "BenchWorkflows.h"
+#include "comfyui_plus_backend/utils/WorkflowIngest.h"
+#include <benchmark/benchmark.h>
+#include <json/json.h>
+#include <memory>
+
+namespace cupb_bench = comfyui_plus_backend::bench;
+namespace cupb_utils = comfyui_plus_backend::app::utils;
+
+namespace
+{
+
+void runSimdjsonIngest(benchmark::State &state, const std::string &body)
+{
+    for (auto _ : state) {
+        auto upload = cupb_utils::WorkflowIngest::parseUpload(body, true);
+        if (!upload) {
+            state.SkipWithError(upload.error().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(upload->summary.nodeCount);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+
+void runJsoncppParse(benchmark::State &state, const std::string &body)
+{
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    for (auto _ : state) {
+        Json::Value root;
+        std::string errors;
+        if (!reader->parse(body.data(), body.data() + body.size(), &root, &errors)) {
+            state.SkipWithError(errors.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(root["json_data"]["nodes"].size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+
+void BM_WorkflowIngest_Simdjson(benchmark::State &state)
+{
+    std::string body = cupb_bench::makeUploadBody(
+        cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0))));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+    runSimdjsonIngest(state, body);
+}
+
+void BM_WorkflowIngest_JsoncppDom(benchmark::State &state)
+{
+    std::string body = cupb_bench::makeUploadBody(
+        cupb_bench::makeSyntheticWorkflow(static_cast<size_t>(state.range(0))));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+    runJsoncppParse(state, body);
+}
+
+} // namespace
+
+// 1k nodes is ~1 MB, 10k ~10 MB and 20k ~20 MB of JSON
+BENCHMARK(BM_WorkflowIngest_Simdjson)->Arg(1000)->Arg(10000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorkflowIngest_JsoncppDom)->Arg(1000)->Arg(10000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+namespace comfyui_plus_backend
+{
+namespace bench
+{
+
+// Registers ingest benchmarks for each real workflow found by loadWorkflowFiles()
+void registerWorkflowIngestFileBenchmarks()
+{
+    for (auto &[name, graph] : loadWorkflowFiles()) {
+        auto body = std::make_shared<std::string>(makeUploadBody(graph));
+        benchmark::RegisterBenchmark(("BM_WorkflowIngest_Simdjson/file:" + name).c_str(),
+                                     [body](benchmark::State &state) { runSimdjsonIngest(state, *body); })
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("BM_WorkflowIngest_JsoncppDom/file:" + name).c_str(),
+                                     [body](benchmark::State &state) { runJsoncppParse(state, *body); })
+            ->Unit(benchmark::kMillisecond);
+    }
+}
+
+} // namespace bench
+} // namespace comfyui_plus_backend
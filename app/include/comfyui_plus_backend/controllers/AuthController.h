@@ -26,8 +26,11 @@ class AuthController final : public drogon::HttpController<AuthController>
     METHOD_LIST_BEGIN
     // Define your routes and the methods they map to.
     // The last argument is a list of HTTP methods allowed for this path.
-    ADD_METHOD_TO(AuthController::handleRegister, "/auth/register", {drogon::HttpMethod::Post});
-    ADD_METHOD_TO(AuthController::handleLogin, "/auth/login", {drogon::HttpMethod::Post});
+    // RateLimitFilter throttles both before any Argon2 work is queued
+    ADD_METHOD_TO(AuthController::handleRegister, "/auth/register", {drogon::HttpMethod::Post},
+                  "comfyui_plus_backend::app::filters::RateLimitFilter");
+    ADD_METHOD_TO(AuthController::handleLogin, "/auth/login", {drogon::HttpMethod::Post},
+                  "comfyui_plus_backend::app::filters::RateLimitFilter");
     // Example for a protected route later:
     // ADD_METHOD_TO(AuthController::getCurrentUser, "/auth/me", {drogon::HttpMethod::Get}, "JwtAuthFilter");
     METHOD_LIST_END
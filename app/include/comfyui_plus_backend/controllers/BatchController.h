@@ -0,0 +1,57 @@
+// app/include/comfyui_plus_backend/controllers/BatchController.h
+#pragma once
+
+#include <drogon/HttpController.h>
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <cstddef>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+/**
+ * @brief POST /batch: many workflow sub-requests in one round trip
+ *
+ * The batch is authenticated once by JwtAuthFilter and each sub-request is
+ * handed to the same WorkflowController handler a standalone request would
+ * reach. Items are applied in order: consecutive reads run in parallel on
+ * db::DbWorkerPool, consecutive creates are inserted in one transaction, and
+ * other writes run one at a time, each in its own transaction.
+ */
+class BatchController final : public drogon::HttpController<BatchController>
+{
+public:
+    BatchController();
+
+    METHOD_LIST_BEGIN
+    ADD_METHOD_TO(BatchController::handleBatch, "/batch", {drogon::HttpMethod::Post},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    METHOD_LIST_END
+
+    void handleBatch(const drogon::HttpRequestPtr &req,
+                     std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+
+    // Sub-requests accepted in one batch
+    static constexpr size_t MAX_ITEMS = 50;
+
+    // Default for `workflows.max_batch_bytes`. Each item body is also held to
+    // `workflows.max_upload_bytes` by the handler it is dispatched to.
+    static constexpr size_t DEFAULT_MAX_BATCH_BYTES = 64 * 1024 * 1024;
+
+private:
+    // Largest batch body accepted; `workflows.max_batch_bytes` in config.json
+    size_t maxBatchBytes_ = DEFAULT_MAX_BATCH_BYTES;
+
+    // Batches wait here for their reads, never on an I/O or DB worker thread;
+    // sized by `threads.batch_workers`
+    trantor::ConcurrentTaskQueue batchQueue_{
+        comfyui_plus_backend::app::utils::ThreadTopology::active().batchWorkers.threads, "Batch"};
+};
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
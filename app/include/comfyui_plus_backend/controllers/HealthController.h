@@ -0,0 +1,37 @@
+// app/include/comfyui_plus_backend/controllers/HealthController.h
+#pragma once
+
+#include <drogon/HttpController.h>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+/**
+ * @brief Liveness and readiness probes for load balancers and orchestrators
+ *
+ * GET /health answers as soon as the server accepts connections. GET
+ * /health/ready returns 503 until every thread's database connection has
+ * been opened and warmed (db::DatabaseManager::warmUpAllConnections()).
+ */
+class HealthController final : public drogon::HttpController<HealthController>
+{
+public:
+    METHOD_LIST_BEGIN
+    ADD_METHOD_TO(HealthController::live, "/health", {drogon::HttpMethod::Get});
+    ADD_METHOD_TO(HealthController::ready, "/health/ready", {drogon::HttpMethod::Get});
+    METHOD_LIST_END
+
+    void live(const drogon::HttpRequestPtr &req,
+              std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+
+    void ready(const drogon::HttpRequestPtr &req,
+               std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+};
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
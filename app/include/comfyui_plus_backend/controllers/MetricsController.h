@@ -0,0 +1,30 @@
+// app/include/comfyui_plus_backend/controllers/MetricsController.h
+#pragma once
+
+#include <drogon/HttpController.h>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+/**
+ * @brief GET /metrics: utils::Metrics plus cache and database gauges in the
+ * Prometheus text format
+ */
+class MetricsController final : public drogon::HttpController<MetricsController>
+{
+public:
+    METHOD_LIST_BEGIN
+    ADD_METHOD_TO(MetricsController::scrape, "/metrics", {drogon::HttpMethod::Get});
+    METHOD_LIST_END
+
+    void scrape(const drogon::HttpRequestPtr &req,
+                std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+};
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -2,7 +2,17 @@
 #pragma once
 
 #include <drogon/HttpController.h>
+#include "comfyui_plus_backend/services/WorkflowService.h"
+#include "comfyui_plus_backend/services/WorkflowGraphService.h"
+#include "comfyui_plus_backend/services/WorkflowPromptService.h"
+#include "comfyui_plus_backend/services/WorkflowEncodingService.h"
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace comfyui_plus_backend
 {
@@ -17,34 +27,85 @@ public:
     WorkflowController();
 
     METHOD_LIST_BEGIN
-    // Define routes without explicitly mentioning any filter.
-    // Our JwtAuthFilter will check paths internally.
-    ADD_METHOD_TO(WorkflowController::getWorkflows, "/workflows", {drogon::HttpMethod::Get});
-    ADD_METHOD_TO(WorkflowController::createWorkflow, "/workflows", {drogon::HttpMethod::Post});
-    ADD_METHOD_TO(WorkflowController::getWorkflowById, "/workflows/{id}", {drogon::HttpMethod::Get});
-    ADD_METHOD_TO(WorkflowController::updateWorkflow, "/workflows/{id}", {drogon::HttpMethod::Put});
-    ADD_METHOD_TO(WorkflowController::deleteWorkflow, "/workflows/{id}", {drogon::HttpMethod::Delete});
+    // Every route names JwtAuthFilter; registering it in main.cc only makes
+    // the name resolvable, it does not run the filter
+    ADD_METHOD_TO(WorkflowController::getWorkflows, "/workflows", {drogon::HttpMethod::Get},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::createWorkflow, "/workflows", {drogon::HttpMethod::Post},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    // Registered before /workflows/{id} so the literal paths win
+    ADD_METHOD_TO(WorkflowController::exportWorkflows, "/workflows/export", {drogon::HttpMethod::Get},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::importWorkflows, "/workflows/import", {drogon::HttpMethod::Post},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::getWorkflowById, "/workflows/{id}", {drogon::HttpMethod::Get},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::updateWorkflow, "/workflows/{id}", {drogon::HttpMethod::Put},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::deleteWorkflow, "/workflows/{id}", {drogon::HttpMethod::Delete},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::getWorkflowAnalysis, "/workflows/{id}/analysis", {drogon::HttpMethod::Get},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
+    ADD_METHOD_TO(WorkflowController::getWorkflowPrompt, "/workflows/{id}/prompt", {drogon::HttpMethod::Get},
+                  "comfyui_plus_backend::app::filters::JwtAuthFilter");
     METHOD_LIST_END
 
-    // Endpoint handler declarations (no changes)
+    // Endpoint handler declarations. The {id} path segment is passed as the last argument.
     void getWorkflows(const drogon::HttpRequestPtr &req,
                      std::function<void(const drogon::HttpResponsePtr &)> &&callback);
                      
     void createWorkflow(const drogon::HttpRequestPtr &req,
                        std::function<void(const drogon::HttpResponsePtr &)> &&callback);
                        
+    // Streams every workflow the caller owns as NDJSON, one create body per line
+    void exportWorkflows(const drogon::HttpRequestPtr &req,
+                         std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+
+    // Creates one workflow per NDJSON line and reports a result per line
+    void importWorkflows(const drogon::HttpRequestPtr &req,
+                         std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+
     void getWorkflowById(const drogon::HttpRequestPtr &req,
-                        std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+                        std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+                        const std::string &id);
                         
     void updateWorkflow(const drogon::HttpRequestPtr &req,
-                       std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+                       std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+                       const std::string &id);
                        
     void deleteWorkflow(const drogon::HttpRequestPtr &req,
-                       std::function<void(const drogon::HttpResponsePtr &)> &&callback);
+                       std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+                       const std::string &id);
+
+    void getWorkflowAnalysis(const drogon::HttpRequestPtr &req,
+                             std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+                             const std::string &id);
+
+    void getWorkflowPrompt(const drogon::HttpRequestPtr &req,
+                           std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+                           const std::string &id);
+
+    // POST /workflows for several bodies, inserted in one transaction. Bodies
+    // that fail validation get their own error; a failed insert fails them all.
+    // Responses match createWorkflow() and are returned in input order.
+    std::vector<drogon::HttpResponsePtr> createWorkflows(int64_t userId,
+                                                         const std::vector<std::string_view> &bodies);
+
+    // Default for `workflows.max_upload_bytes`
+    static constexpr size_t DEFAULT_MAX_UPLOAD_BYTES = 48 * 1024 * 1024;
 
 private:
-    // Will add WorkflowService when implemented
-    // std::shared_ptr<WorkflowService> workflowService_;
+    std::shared_ptr<comfyui_plus_backend::app::services::WorkflowService> workflowService_;
+    std::shared_ptr<comfyui_plus_backend::app::services::WorkflowGraphService> graphService_;
+    std::shared_ptr<comfyui_plus_backend::app::services::WorkflowPromptService> promptService_;
+    std::shared_ptr<comfyui_plus_backend::app::services::WorkflowEncodingService> encodingService_;
+
+    // Largest create/update body accepted; `workflows.max_upload_bytes` in config.json
+    size_t maxUploadBytes_ = DEFAULT_MAX_UPLOAD_BYTES;
+
+    // Imports run here rather than on an I/O thread; `threads.import_workers` at a time
+    trantor::ConcurrentTaskQueue importQueue_{
+        comfyui_plus_backend::app::utils::ThreadTopology::active().importWorkers.threads, "WorkflowImport"};
 };
 
 } // namespace controllers
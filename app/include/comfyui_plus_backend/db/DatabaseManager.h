@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <mutex>
@@ -39,6 +40,18 @@ public:
     // Check if the database is initialized
     bool isInitialized() const;
 
+    // Opens this thread's connection if needed and runs each hot lookup once,
+    // so the schema is parsed and index pages are cached before real traffic
+    void warmUpConnection();
+
+    // Warms the connection of every thread that queries the database: each
+    // Drogon I/O loop, DbWorkerPool worker and PasswordHashPool worker.
+    // Returns at once; call it once the I/O loops run (a beginning advice).
+    void warmUpAllConnections();
+
+    // Whether warmUpAllConnections() has finished; reported by /health/ready
+    bool isWarm() const;
+
 private:
     // Private constructor for singleton pattern
     DatabaseManager();
@@ -52,6 +65,11 @@ private:
     
     // Synchronize database schema
     void syncSchema();
+
+    // Schema changes sync_schema() cannot make without losing rows, tracked
+    // in PRAGMA user_version; run around the first syncSchema()
+    void migrateBeforeSync();
+    void migrateAfterSync();
     
     // Thread-local storage for per-thread database access
     struct ThreadLocalData {
@@ -71,6 +89,9 @@ private:
     
     // Initialization flag
     bool initialized_ = false;
+
+    // Set once every thread's connection is warm
+    std::atomic<bool> warm_{false};
 };
 
 } // namespace db
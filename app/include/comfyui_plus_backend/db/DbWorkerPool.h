@@ -0,0 +1,34 @@
+// app/include/comfyui_plus_backend/db/DbWorkerPool.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/WorkerPool.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace db
+{
+
+/**
+ * @brief Worker threads for database reads that fan out from one request,
+ * and for the pages of streamed listings and exports
+ *
+ * Each worker gets its own SQLite connection the first time it calls
+ * DatabaseManager::getStorage(), so tasks queued here read concurrently.
+ * Tasks must not wait on other tasks in this pool. Sized by
+ * `threads.db_workers` in config.json (see utils::ThreadTopology).
+ */
+class DbWorkerPool : public utils::WorkerPool
+{
+public:
+    // Get the singleton instance
+    static DbWorkerPool& getInstance();
+
+private:
+    DbWorkerPool();
+};
+
+} // namespace db
+} // namespace app
+} // namespace comfyui_plus_backend
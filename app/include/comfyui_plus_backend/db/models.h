@@ -1,7 +1,10 @@
 #pragma once
 
+#include "comfyui_plus_backend/utils/Reflect.h"
+#include <cstdint>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace comfyui_plus_backend
 {
@@ -23,8 +26,20 @@ struct User {
     std::string username;
     std::string email;
     std::string hashedPassword;
-    std::string createdAt;
-    std::string updatedAt;
+    int64_t createdAt = 0;      // Epoch microseconds, as trantor::Date stores them
+    int64_t updatedAt = 0;
+
+    // Column names; the password hash never leaves the database layer
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &User::id),
+                               reflect::field("username", &User::username),
+                               reflect::field("email", &User::email),
+                               reflect::sensitiveField("hashed_password", &User::hashedPassword),
+                               reflect::field("created_at", &User::createdAt),
+                               reflect::field("updated_at", &User::updatedAt));
+    }
 };
 
 /**
@@ -38,11 +53,46 @@ struct Workflow {
     int64_t userId;
     std::string name;
     std::string description;
-    std::string jsonData;
+    std::string jsonData;       // Semantic graph; layout fields are split out at ingest
+    std::string layoutData;     // Editor layout (positions, sizes, groups, viewport)
     std::string thumbnailPath;  // Path to workflow thumbnail image
-    std::string createdAt;
-    std::string updatedAt;
+    int64_t createdAt = 0;      // Epoch microseconds, as trantor::Date stores them
+    int64_t updatedAt = 0;
     bool isPublic = false;
+    int64_t version = 1;        // Incremented on every update
+    int64_t nodeCount = 0;      // Extracted from json_data at ingest time
+    std::string contentHash;    // SHA-256 over json_data and layout_data, set on write
+
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &Workflow::id),
+                               reflect::field("user_id", &Workflow::userId),
+                               reflect::field("name", &Workflow::name),
+                               reflect::field("description", &Workflow::description),
+                               reflect::field("json_data", &Workflow::jsonData),
+                               reflect::field("layout_data", &Workflow::layoutData),
+                               reflect::field("thumbnail_path", &Workflow::thumbnailPath),
+                               reflect::field("created_at", &Workflow::createdAt),
+                               reflect::field("updated_at", &Workflow::updatedAt),
+                               reflect::field("is_public", &Workflow::isPublic),
+                               reflect::field("version", &Workflow::version),
+                               reflect::field("node_count", &Workflow::nodeCount),
+                               reflect::field("content_hash", &Workflow::contentHash));
+    }
+};
+
+/**
+ * @brief Precompressed response body for one workflow version
+ *
+ * One row per (workflow, Content-Encoding); rows whose version is behind the
+ * workflow's are stale and ignored until the encoder replaces them.
+ */
+struct WorkflowEncoding {
+    int64_t workflowId;
+    std::string encoding;       // Content-Encoding token, "br" or "gzip"
+    int64_t version;            // Workflow version the body was rendered from
+    std::vector<char> body;
 };
 
 /**
@@ -53,6 +103,12 @@ struct Workflow {
 struct Tag {
     std::optional<int64_t> id;
     std::string name;
+
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &Tag::id), reflect::field("name", &Tag::name));
+    }
 };
 
 /**
@@ -65,6 +121,14 @@ struct WorkflowTag {
     std::optional<int64_t> id;
     int64_t workflowId;
     int64_t tagId;
+
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &WorkflowTag::id),
+                               reflect::field("workflow_id", &WorkflowTag::workflowId),
+                               reflect::field("tag_id", &WorkflowTag::tagId));
+    }
 };
 
 } // namespace models
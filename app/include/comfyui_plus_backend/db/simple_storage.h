@@ -31,17 +31,33 @@ inline auto createStorage(const std::string& dbPath) {
         
         // Workflows table
         make_table("workflows",
-            make_column("id", &Workflow::id, primary_key()),  // Removed autoincrement
+            // AUTOINCREMENT: a deleted workflow's id is never handed out again,
+            // so (id, version) names one workflow's content for good
+            make_column("id", &Workflow::id, primary_key().autoincrement()),
             make_column("user_id", &Workflow::userId),
             make_column("name", &Workflow::name),
             make_column("description", &Workflow::description),
             make_column("json_data", &Workflow::jsonData),
+            make_column("layout_data", &Workflow::layoutData, default_value("")),
             make_column("thumbnail_path", &Workflow::thumbnailPath),
             make_column("created_at", &Workflow::createdAt),
             make_column("updated_at", &Workflow::updatedAt),
             make_column("is_public", &Workflow::isPublic),
+            make_column("version", &Workflow::version, default_value(1)),
+            make_column("node_count", &Workflow::nodeCount, default_value(0)),
+            make_column("content_hash", &Workflow::contentHash, default_value("")),
             foreign_key(&Workflow::userId).references(&User::id)
         ),
+
+        // Precompressed GET /workflows/{id} bodies
+        make_table("workflow_encodings",
+            make_column("workflow_id", &WorkflowEncoding::workflowId),
+            make_column("encoding", &WorkflowEncoding::encoding),
+            make_column("version", &WorkflowEncoding::version),
+            make_column("body", &WorkflowEncoding::body),
+            primary_key(&WorkflowEncoding::workflowId, &WorkflowEncoding::encoding),
+            foreign_key(&WorkflowEncoding::workflowId).references(&Workflow::id)
+        ),
         
         // Tags table
         make_table("tags",
@@ -5,6 +5,7 @@
 #include <string>
 #include <regex>
 #include "comfyui_plus_backend/services/JwtService.h"  // Include JwtService
+#include "comfyui_plus_backend/utils/Log.h"
 #include <jwt-cpp/jwt.h>  // Include JWT-CPP for JWT types
 
 namespace comfyui_plus_backend
@@ -31,6 +32,10 @@ public:
 private:
     // Helper method to check if a path should be protected
     bool isProtectedPath(const std::string& path);
+
+    // Built once from the JWT config; verification only reads it, so the
+    // I/O threads share it
+    services::JwtService jwtService_;
 };
 
 } // namespace filters
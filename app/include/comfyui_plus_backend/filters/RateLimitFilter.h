@@ -0,0 +1,70 @@
+// app/include/comfyui_plus_backend/filters/RateLimitFilter.h
+#pragma once
+
+#include <drogon/HttpFilter.h>
+#include "comfyui_plus_backend/utils/RateLimiter.h"
+#include <json/json.h>
+#include <expected>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace filters
+{
+
+/**
+ * @brief Throttles POST /auth/login and /auth/register, whose Argon2 work
+ * makes them the most expensive routes
+ *
+ * A request first takes a token from its client IP's bucket; that check
+ * comes before the body is read, so a flood from one address is answered
+ * with 429 for the cost of a hash lookup. The body is then parsed, bounded by
+ * the request's maxJsonBytes, and a token is taken from the account's bucket
+ * (the login identifier or the username registered). The parsed body is left
+ * in kParsedBodyAttribute so that AuthController does not parse it again.
+ *
+ * Clients in `exempt_ips` skip both checks.
+ *
+ * Limits come from the `rate_limits` section of config.json. Registered with
+ * drogon::app().registerFilter() and named in AuthController's routes.
+ */
+class RateLimitFilter : public drogon::HttpFilter<RateLimitFilter, false>
+{
+public:
+    struct Settings {
+        bool enabled = true;
+        utils::RateLimiter::Limit perIp{30.0 / 60.0, 10};
+        utils::RateLimiter::Limit perAccount{10.0 / 60.0, 5};
+        size_t maxKeys = 100000;      // Per limiter
+        bool useForwardedFor = false; // Take the client IP from X-Forwarded-For
+        // Never limited, e.g. loopback for a local load test; none by default
+        std::unordered_set<std::string> exemptIps;
+    };
+
+    // Reads `rate_limits`; a null section gives the defaults
+    static std::expected<Settings, std::string> settingsFromConfig(const Json::Value &section);
+
+    // Where the parsed LoginRequest or RegisterRequest is left for the handler
+    static constexpr const char *kParsedBodyAttribute = "rate_limit_parsed_body";
+
+    explicit RateLimitFilter(const Settings &settings);
+
+    void doFilter(const drogon::HttpRequestPtr& req,
+                  drogon::FilterCallback&& fcb,
+                  drogon::FilterChainCallback&& fccb) override;
+
+private:
+    std::string clientIp(const drogon::HttpRequestPtr& req) const;
+
+    Settings settings_;
+    std::shared_ptr<utils::RateLimiter> perIp_;
+    std::shared_ptr<utils::RateLimiter> perAccount_;
+};
+
+} // namespace filters
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,84 @@
+// app/include/comfyui_plus_backend/graph/PromptConverter.h
+#pragma once
+
+#include <expected>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+/**
+ * @brief The widget inputs of one node type, in the order the editor stores them
+ */
+struct NodeSchema {
+    struct Widget {
+        std::string name;
+        // The editor stores an extra "fixed"/"randomize" value after this widget
+        bool controlAfterGenerate = false;
+    };
+    std::vector<Widget> widgets;
+};
+
+/**
+ * @brief Widget layouts per node type, loaded from a ComfyUI `/object_info` dump
+ *
+ * UI-format workflows store widget values positionally (`widgets_values`);
+ * the schema supplies the input names those positions map to.
+ */
+class NodeSchemaRegistry
+{
+public:
+    NodeSchemaRegistry() = default;
+
+    // Parses the body of ComfyUI's GET /object_info
+    static std::expected<NodeSchemaRegistry, std::string> fromObjectInfo(std::string_view json);
+
+    // Reads and parses an /object_info dump saved to disk
+    static std::expected<NodeSchemaRegistry, std::string> loadFile(const std::string& path);
+
+    // Returns the schema for classType, or nullptr when the type is unknown
+    const NodeSchema* find(std::string_view classType) const;
+
+    size_t size() const { return schemas_.size(); }
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    std::unordered_map<std::string, NodeSchema, StringHash, std::equal_to<>> schemas_;
+};
+
+/**
+ * @brief Converts editor (UI-format) workflows into ComfyUI `/prompt` API prompts
+ *
+ * Links are resolved through Reroute nodes and bypassed nodes, PrimitiveNode
+ * values are inlined into their targets, muted nodes are dropped, and all
+ * layout data (positions, sizes, colours, groups) is discarded. Widget values
+ * are copied as the exact JSON the editor wrote.
+ */
+class PromptConverter
+{
+public:
+    explicit PromptConverter(const NodeSchemaRegistry& schemas) : schemas_(schemas) {}
+
+    // Returns the API prompt as a JSON object string. A workflow that is
+    // already in API format is returned unchanged.
+    std::expected<std::string, std::string> convert(std::string_view jsonData) const;
+
+private:
+    const NodeSchemaRegistry& schemas_;
+};
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,93 @@
+// app/include/comfyui_plus_backend/graph/WorkflowGraph.h
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+/**
+ * @brief A link whose origin or target node does not exist in the graph
+ */
+struct DanglingLink {
+    int64_t linkId = -1;        // -1 for API-format inputs, which have no link id
+    std::string originNode;
+    std::string targetNode;
+    bool missingOrigin = false;
+    bool missingTarget = false;
+};
+
+/**
+ * @brief Compact, immutable node/link structure of a ComfyUI workflow
+ *
+ * Nodes are addressed by a dense index; edges are kept in CSR form
+ * (offsets_ + targets_) so walking a node's successors is a linear scan over
+ * contiguous memory. Both the UI format (`nodes`/`links`) and the API prompt
+ * format are accepted.
+ */
+class WorkflowGraph
+{
+public:
+    // Parses the json_data of a workflow. Returns a client-facing error on failure.
+    static std::expected<WorkflowGraph, std::string> parse(std::string_view jsonData);
+
+    size_t nodeCount() const { return nodeKeys_.size(); }
+    size_t edgeCount() const { return targets_.size(); }
+
+    // The ComfyUI node id of the node at index
+    const std::string& nodeKey(uint32_t index) const { return nodeKeys_[index]; }
+
+    // The type id of the node at index; ids are dense per graph, in order of
+    // first appearance, so nothing outlives the graph an upload produced
+    uint32_t nodeType(uint32_t index) const { return nodeTypes_[index]; }
+
+    size_t typeCount() const { return typeNames_.size(); }
+    const std::string& typeName(uint32_t id) const { return typeNames_[id]; }
+
+    // Indices of the nodes fed by the node at index, one entry per link
+    std::span<const uint32_t> successors(uint32_t index) const {
+        return {targets_.data() + offsets_[index], targets_.data() + offsets_[index + 1]};
+    }
+
+    const std::vector<DanglingLink>& danglingLinks() const { return danglingLinks_; }
+
+private:
+    friend class GraphBuilder;
+
+    std::vector<std::string> nodeKeys_;
+    std::vector<uint32_t> nodeTypes_;
+    std::vector<std::string> typeNames_; // Indexed by type id
+    std::vector<uint32_t> offsets_;   // Size nodeCount() + 1
+    std::vector<uint32_t> targets_;
+    std::vector<DanglingLink> danglingLinks_;
+};
+
+/**
+ * @brief Results of analysing a WorkflowGraph
+ */
+struct GraphAnalysis {
+    size_t nodeCount = 0;
+    size_t linkCount = 0;
+    bool hasCycle = false;
+    std::vector<std::string> topologicalOrder;  // Node ids; partial when hasCycle
+    std::vector<std::string> cycleNodes;        // Nodes on or downstream of a cycle
+    std::vector<DanglingLink> danglingLinks;
+    std::vector<std::pair<std::string, size_t>> typeCounts; // Most frequent first
+};
+
+// Computes topological order (Kahn), cycle membership, dangling links and per-type counts
+GraphAnalysis analyzeGraph(const WorkflowGraph& graph);
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,45 @@
+// app/include/comfyui_plus_backend/graph/WorkflowLayout.h
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+/**
+ * @brief A workflow body split into its semantic graph and its editor layout
+ *
+ * `graph` is the original document minus layout data: nodes keep their id,
+ * type, mode, inputs, outputs, widgets and properties, and links are kept
+ * as-is. `layout` holds what only the editor needs:
+ *
+ *     {"nodes": {"<id>": {"pos": ..., "size": ..., ...}}, "groups": [...], "extra": {...}}
+ *
+ * Every value is copied as the exact JSON the client wrote. API-format
+ * prompts have no layout; their layout is empty and the graph is unchanged.
+ */
+struct WorkflowParts {
+    std::string graph;
+    std::string layout; // Empty when the workflow has no layout data
+};
+
+// Splits a validated workflow body. Returns a client-facing error on failure.
+// When capacity (bytes readable from jsonData.data()) leaves room for
+// simdjson's padding, the body is parsed in place instead of being copied;
+// WorkflowUpload::jsonDataCapacity provides it for freshly ingested bodies.
+std::expected<WorkflowParts, std::string> splitLayout(std::string_view jsonData, size_t capacity = 0);
+
+// Reassembles the body that splitLayout() was given. Fields come back in a
+// graph-then-layout order, so the result is equivalent but not byte-identical.
+std::expected<std::string, std::string> mergeLayout(std::string_view graph, std::string_view layout);
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,61 @@
+// app/include/comfyui_plus_backend/models/AuthRequests.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/Reflect.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace models
+{
+
+// Longest password accepted at registration. Argon2 hashes the whole
+// input, so an unbounded password is a cheap way to burn server CPU.
+constexpr size_t kMaxPasswordLength = 128;
+
+// Body of POST /auth/register
+struct RegisterRequest {
+    std::string username;
+    std::string email;
+    std::string password;
+
+    static constexpr size_t maxJsonBytes = 4096;
+
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("username", &RegisterRequest::username).length(3, 64),
+                               reflect::field("email", &RegisterRequest::email).length(3, 254),
+                               reflect::sensitiveField("password", &RegisterRequest::password)
+                                   .length(8, kMaxPasswordLength));
+    }
+};
+
+// Body of POST /auth/login; one of the three identifiers is required
+struct LoginRequest {
+    std::optional<std::string> emailOrUsername;
+    std::optional<std::string> username;
+    std::optional<std::string> email;
+    std::string password;
+
+    static constexpr size_t maxJsonBytes = 4096;
+
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("emailOrUsername", &LoginRequest::emailOrUsername).length(1, 254),
+                               reflect::field("username", &LoginRequest::username).length(1, 254),
+                               reflect::field("email", &LoginRequest::email).length(1, 254),
+                               // Not capped at kMaxPasswordLength: accounts registered before
+                               // the cap must still log in; maxJsonBytes bounds the hashing
+                               reflect::sensitiveField("password", &LoginRequest::password));
+    }
+};
+
+} // namespace models
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -1,6 +1,7 @@
 // app/include/comfyui_plus_backend/models/User.h
 #pragma once
 
+#include "comfyui_plus_backend/utils/Reflect.h"
 #include <drogon/orm/Result.h>
 #include <drogon/orm/Row.h>
 #include <drogon/orm/Field.h>
@@ -29,21 +30,33 @@ class User
     std::optional<std::int64_t> getId() const { return id_; }
     void setId(const std::int64_t &id) { id_ = id; }
 
-    std::string getUsername() const { return username_; }
-    void setUsername(const std::string &username) { username_ = username; }
+    const std::string &getUsername() const { return username_; }
+    void setUsername(std::string username) { username_ = std::move(username); }
 
-    std::string getEmail() const { return email_; }
-    void setEmail(const std::string &email) { email_ = email; }
+    const std::string &getEmail() const { return email_; }
+    void setEmail(std::string email) { email_ = std::move(email); }
 
-    std::string getHashedPassword() const { return hashedPassword_; }
-    void setHashedPassword(const std::string &hashedPassword) { hashedPassword_ = hashedPassword; }
+    const std::string &getHashedPassword() const { return hashedPassword_; }
+    void setHashedPassword(std::string hashedPassword) { hashedPassword_ = std::move(hashedPassword); }
 
-    trantor::Date getCreatedAt() const { return createdAt_; }
+    const trantor::Date &getCreatedAt() const { return createdAt_; }
     void setCreatedAt(const trantor::Date &createdAt) { createdAt_ = createdAt; }
 
-    trantor::Date getUpdatedAt() const { return updatedAt_; }
+    const trantor::Date &getUpdatedAt() const { return updatedAt_; }
     void setUpdatedAt(const trantor::Date &updatedAt) { updatedAt_ = updatedAt; }
 
+    // Response fields; sensitive ones are compiled out of every serializer
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &User::getId),
+                               reflect::field("username", &User::getUsername),
+                               reflect::field("email", &User::getEmail),
+                               reflect::sensitiveField("hashed_password", &User::getHashedPassword),
+                               reflect::field("created_at", &User::getCreatedAt),
+                               reflect::field("updated_at", &User::getUpdatedAt));
+    }
+
   private:
     // Member variables
     std::optional<int64_t> id_;
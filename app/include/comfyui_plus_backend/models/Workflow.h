@@ -0,0 +1,100 @@
+// app/include/comfyui_plus_backend/models/Workflow.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/Reflect.h"
+#include <trantor/utils/Date.h> // For timestamps
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace models
+{
+
+class Workflow
+{
+  public:
+    Workflow() = default;
+
+    // Getters and Setters
+    std::optional<std::int64_t> getId() const { return id_; }
+    void setId(const std::int64_t &id) { id_ = id; }
+
+    std::int64_t getUserId() const { return userId_; }
+    void setUserId(const std::int64_t &userId) { userId_ = userId; }
+
+    const std::string &getName() const { return name_; }
+    void setName(std::string name) { name_ = std::move(name); }
+
+    const std::string &getDescription() const { return description_; }
+    void setDescription(std::string description) { description_ = std::move(description); }
+
+    // The graph body can be tens of megabytes, so it is never copied out
+    const std::string &getJsonData() const { return jsonData_; }
+    void setJsonData(std::string jsonData) { jsonData_ = std::move(jsonData); }
+
+    // Editor-only layout split from the graph at ingest; see graph::WorkflowParts
+    const std::string &getLayoutData() const { return layoutData_; }
+    void setLayoutData(std::string layoutData) { layoutData_ = std::move(layoutData); }
+
+    const std::string &getThumbnailPath() const { return thumbnailPath_; }
+    void setThumbnailPath(std::string thumbnailPath) { thumbnailPath_ = std::move(thumbnailPath); }
+
+    bool getIsPublic() const { return isPublic_; }
+    void setIsPublic(bool isPublic) { isPublic_ = isPublic; }
+
+    std::int64_t getVersion() const { return version_; }
+    void setVersion(const std::int64_t &version) { version_ = version; }
+
+    std::int64_t getNodeCount() const { return nodeCount_; }
+    void setNodeCount(const std::int64_t &nodeCount) { nodeCount_ = nodeCount; }
+
+    // Hex SHA-256 of the stored body; empty for rows written before it existed
+    const std::string &getContentHash() const { return contentHash_; }
+    void setContentHash(std::string contentHash) { contentHash_ = std::move(contentHash); }
+
+    const trantor::Date &getCreatedAt() const { return createdAt_; }
+    void setCreatedAt(const trantor::Date &createdAt) { createdAt_ = createdAt; }
+
+    const trantor::Date &getUpdatedAt() const { return updatedAt_; }
+    void setUpdatedAt(const trantor::Date &updatedAt) { updatedAt_ = updatedAt; }
+
+    // Metadata fields of API responses; the bodies are spliced in separately
+    static constexpr auto jsonFields()
+    {
+        namespace reflect = utils::reflect;
+        return reflect::fields(reflect::field("id", &Workflow::getId),
+                               reflect::field("user_id", &Workflow::getUserId),
+                               reflect::field("name", &Workflow::getName),
+                               reflect::field("description", &Workflow::getDescription),
+                               reflect::field("thumbnail_path", &Workflow::getThumbnailPath),
+                               reflect::field("is_public", &Workflow::getIsPublic),
+                               reflect::field("version", &Workflow::getVersion),
+                               reflect::field("node_count", &Workflow::getNodeCount),
+                               reflect::field("created_at", &Workflow::getCreatedAt),
+                               reflect::field("updated_at", &Workflow::getUpdatedAt));
+    }
+
+  private:
+    // Member variables
+    std::optional<int64_t> id_;
+    int64_t userId_ = 0;
+    std::string name_;
+    std::string description_;
+    std::string jsonData_;
+    std::string layoutData_;
+    std::string thumbnailPath_;
+    bool isPublic_ = false;
+    int64_t version_ = 1;
+    int64_t nodeCount_ = 0;
+    std::string contentHash_;
+    trantor::Date createdAt_;
+    trantor::Date updatedAt_;
+};
+
+} // namespace models
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,110 @@
+// app/include/comfyui_plus_backend/services/UserCache.h
+#pragma once
+
+#include "comfyui_plus_backend/models/User.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Process-wide LRU of user records, looked up by id, username or email
+ *
+ * Records are split across shards by id, each with its own lock and LRU
+ * list, so concurrent lookups of different users rarely contend. Username
+ * and email indexes map to ids and are checked against the record they
+ * reach, so a stale index entry is only ever a miss.
+ *
+ * Fills race with writes: take generation() before reading the database and
+ * pass it to put(); a record read before an invalidation is dropped. Every
+ * write to a user row must call invalidate() once it commits.
+ */
+class UserCache
+{
+public:
+    // Get the singleton instance
+    static UserCache& getInstance();
+
+    std::optional<models::User> findById(int64_t userId);
+    std::optional<models::User> findByUsername(const std::string &username);
+    std::optional<models::User> findByEmail(const std::string &email);
+
+    // Taken before a database read; see put()
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+    // Caches a record read from the database, unless an invalidation has
+    // happened since `generation` was taken
+    void put(const models::User &user, uint64_t generation);
+
+    // Drops a user's record; call after any write to the user's row
+    void invalidate(int64_t userId);
+
+    // Drops index entries for names that now belong to a different user
+    void invalidateNames(const std::string &username, const std::string &email);
+
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+    double hitRate() const;
+    size_t size() const;
+    size_t capacity() const { return shardCapacity_ * kShardCount; }
+
+private:
+    UserCache();
+
+    UserCache(const UserCache&) = delete;
+    UserCache& operator=(const UserCache&) = delete;
+
+    static constexpr size_t kShardCount = 16;
+
+    struct Entry {
+        int64_t id;
+        std::shared_ptr<const models::User> user;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> entries; // Most recently used first
+        std::unordered_map<int64_t, std::list<Entry>::iterator> index;
+    };
+
+    // username or email -> id
+    struct NameShard {
+        std::mutex mutex;
+        std::unordered_map<std::string, int64_t> ids;
+    };
+
+    using NameIndex = std::array<NameShard, kShardCount>;
+
+    Shard &shardFor(int64_t userId) { return shards_[static_cast<uint64_t>(userId) % kShardCount]; }
+    static NameShard &shardFor(NameIndex &index, const std::string &name);
+
+    // Returns the record without touching the hit counters
+    std::shared_ptr<const models::User> lookup(int64_t userId);
+    std::optional<models::User> findByName(NameIndex &index, const std::string &name, bool byEmail);
+    static void eraseName(NameIndex &index, const std::string &name, int64_t userId);
+
+    size_t shardCapacity_;
+    std::array<Shard, kShardCount> shards_;
+    NameIndex usernames_;
+    NameIndex emails_;
+
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,73 @@
+// app/include/comfyui_plus_backend/services/UserExistenceFilter.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/BloomFilter.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Bloom filters over every registered username and email
+ *
+ * Lets registration skip its existence queries for names that are certainly
+ * free. A "might exist" answer still goes to SQLite, and the UNIQUE
+ * constraints on insert remain the source of truth, so a name added by
+ * another thread a moment ago is caught there.
+ *
+ * Until load() has run every name might exist, so nothing is skipped.
+ */
+class UserExistenceFilter
+{
+public:
+    // Get the singleton instance
+    static UserExistenceFilter& getInstance();
+
+    // Replaces the filters with ones built from all (username, email) rows
+    void load(const std::vector<std::pair<std::string, std::string>> &users);
+
+    bool mightHaveUsername(std::string_view username) const;
+    bool mightHaveEmail(std::string_view email) const;
+
+    // Records a newly inserted user
+    void add(std::string_view username, std::string_view email);
+
+    // True once more users were added than the filters were sized for; the
+    // false positive rate then climbs and the filters should be reloaded
+    bool saturated() const;
+
+    // Target false positive rate of each filter
+    static constexpr double FALSE_POSITIVE_RATE = 0.01;
+
+private:
+    UserExistenceFilter() = default;
+
+    UserExistenceFilter(const UserExistenceFilter&) = delete;
+    UserExistenceFilter& operator=(const UserExistenceFilter&) = delete;
+
+    struct Filters {
+        explicit Filters(size_t expectedItems)
+            : usernames(expectedItems, FALSE_POSITIVE_RATE),
+              emails(expectedItems, FALSE_POSITIVE_RATE) {}
+
+        utils::BloomFilter usernames;
+        utils::BloomFilter emails;
+        std::atomic<size_t> count{0};
+    };
+
+    std::atomic<std::shared_ptr<Filters>> filters_;
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
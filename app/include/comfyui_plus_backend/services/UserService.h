@@ -3,6 +3,7 @@
 #include "comfyui_plus_backend/db/DatabaseManager.h"
 #include "comfyui_plus_backend/models/User.h" // Your Drogon-style User model (DTO)
 #include "comfyui_plus_backend/db/models.h" // Include the db models directly
+#include <expected>
 #include <string>
 #include <optional>
 #include <memory> // For std::shared_ptr
@@ -20,21 +21,40 @@ class UserService
     UserService(); // Constructor to initialize database connection
     ~UserService(); // Destructor to ensure clean shutdown
 
-    // Creates a user and returns the created user model (DTO), or std::nullopt on failure.
-    // The password provided here is the plain text password.
-    std::optional<comfyui_plus_backend::app::models::User> createUser(
+    /**
+     * @brief Why createUser() failed
+     */
+    struct CreateUserError {
+        enum class Kind {
+            Conflict,  // The username or email belongs to another user
+            Internal
+        };
+
+        Kind kind;
+        std::string message;
+    };
+
+    // Creates a user and returns the created user model (DTO), or the reason it failed.
+    // The password provided here is the plain text password. The UNIQUE constraints
+    // on username and email decide conflicts; a violation is reported as Kind::Conflict.
+    std::expected<comfyui_plus_backend::app::models::User, CreateUserError> createUser(
         const std::string &username,
         const std::string &email,
         const std::string &plainPassword);
 
-    // These methods return the User DTO (safe for client)
+    // These methods return the User DTO (safe for client). Records are
+    // served from UserCache when present and cached after a database read.
     std::optional<comfyui_plus_backend::app::models::User> getUserByEmail(const std::string &email);
     std::optional<comfyui_plus_backend::app::models::User> getUserByUsername(const std::string &username);
     std::optional<comfyui_plus_backend::app::models::User> getUserById(int64_t userId);
 
-    // Helper to check if username or email already exists
+    // Helper to check if username or email already exists. Names that
+    // UserExistenceFilter rules out are answered without a query.
     bool userExists(const std::string& username, const std::string& email);
 
+    // Builds UserExistenceFilter from the users table; call once at startup
+    bool loadExistenceFilter();
+
     // Internal method for AuthService to get the hashed password for verification.
     // This should not be part of the public API of UserService if possible,
     // or should return a very specific internal struct.
@@ -45,8 +65,8 @@ class UserService
     // Access to the database storage
     db::DatabaseManager& dbManager_;
 
-    // Converts DB model to your application's User model DTO
-    comfyui_plus_backend::app::models::User dbModelToUserModel(const comfyui_plus_backend::app::db::models::User& dbUser);
+    // Converts DB model to your application's User model DTO, consuming its strings
+    comfyui_plus_backend::app::models::User dbModelToUserModel(comfyui_plus_backend::app::db::models::User&& dbUser);
 
     // Thread safety is handled by sqlite_orm's internal locks and 
     // by having separate connections per thread if needed
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/models/Workflow.h"
+#include "comfyui_plus_backend/services/WorkflowService.h"
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Precompressed gzip and brotli variants of GET /workflows/{id} bodies
+ *
+ * After each write the merged response body is rendered and compressed once
+ * on a background queue and stored in `workflow_encodings`, tagged with the
+ * workflow version. Reads pick a stored variant whose version matches the
+ * current one and send it verbatim, so serving costs no compression CPU on
+ * the IO threads. Until the encoder catches up, reads fall back to identity.
+ */
+class WorkflowEncodingService
+{
+  public:
+    enum class Encoding {
+        Brotli,
+        Gzip
+    };
+
+    // The Content-Encoding token for an encoding
+    static std::string_view encodingName(Encoding encoding);
+
+    WorkflowEncodingService(std::shared_ptr<WorkflowService> workflowService,
+                            const utils::PoolTopology &workers);
+
+    /**
+     * @brief A stored variant ready to be sent as-is
+     */
+    struct EncodedBody {
+        Encoding encoding;
+        std::string body;
+    };
+
+    /**
+     * @brief Queues rendering and compression of the current workflow version
+     *
+     * Safe to call after every write; a job that finds its variants already
+     * current, or a newer version stored, does nothing.
+     *
+     * @param workflowId The workflow that was written
+     * @param ownerId The workflow's owner, used to load it
+     */
+    void scheduleEncode(int64_t workflowId, int64_t ownerId);
+
+    /**
+     * @brief Returns the first variant in accepted order stored for the metadata's version
+     *
+     * @param metadata The caller-visible workflow, as read for this request
+     * @param accepted Encodings the client accepts, most preferred first
+     * @return The stored body, or nullopt when none is current
+     */
+    std::optional<EncodedBody> findEncoded(const comfyui_plus_backend::app::models::Workflow &metadata,
+                                           std::span<const Encoding> accepted);
+
+  private:
+    void encode(int64_t workflowId, int64_t ownerId);
+
+    db::DatabaseManager& dbManager_;
+    std::shared_ptr<WorkflowService> workflowService_;
+
+    // Declared last so queued jobs finish before the members they use go away
+    trantor::ConcurrentTaskQueue queue_;
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
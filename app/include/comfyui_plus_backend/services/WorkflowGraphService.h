@@ -0,0 +1,58 @@
+#pragma once
+
+#include "comfyui_plus_backend/graph/WorkflowGraph.h"
+#include "comfyui_plus_backend/services/WorkflowService.h"
+#include "comfyui_plus_backend/utils/VersionedLruCache.h"
+#include <expected>
+#include <memory>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Structural analysis of stored workflows, cached per workflow version
+ *
+ * A cache hit costs one metadata query to learn the current version; the
+ * graph body is only loaded and parsed when that version has not been
+ * analysed yet.
+ */
+class WorkflowGraphService
+{
+  public:
+    explicit WorkflowGraphService(std::shared_ptr<WorkflowService> workflowService,
+                                  size_t cacheCapacity = 256);
+
+    /**
+     * @brief A workflow analysis tagged with the version it describes
+     */
+    struct VersionedAnalysis {
+        int64_t version = 0;
+        std::shared_ptr<const graph::GraphAnalysis> analysis;
+    };
+
+    /**
+     * @brief Returns the analysis of the current version of a visible workflow
+     *
+     * @param workflowId The workflow to analyse
+     * @param userId The caller
+     * @return The analysis or a WorkflowError (422 if json_data cannot be parsed as a graph)
+     */
+    std::expected<VersionedAnalysis, WorkflowService::WorkflowError> getAnalysis(
+        int64_t workflowId,
+        int64_t userId);
+
+    // Drops any cached analysis for a deleted workflow
+    void invalidate(int64_t workflowId);
+
+  private:
+    std::shared_ptr<WorkflowService> workflowService_;
+    utils::VersionedLruCache<graph::GraphAnalysis> cache_;
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
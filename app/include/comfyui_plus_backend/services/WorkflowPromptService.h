@@ -0,0 +1,60 @@
+#pragma once
+
+#include "comfyui_plus_backend/graph/PromptConverter.h"
+#include "comfyui_plus_backend/services/WorkflowService.h"
+#include "comfyui_plus_backend/utils/VersionedLruCache.h"
+#include <expected>
+#include <memory>
+#include <string>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Produces ComfyUI `/prompt` API prompts from stored workflows
+ *
+ * Conversion results are memoized per workflow version, so repeated runs of
+ * an unchanged workflow cost one metadata query and no parsing. Widget names
+ * come from the `/object_info` dump configured as `comfyui.object_info_path`.
+ */
+class WorkflowPromptService
+{
+  public:
+    explicit WorkflowPromptService(std::shared_ptr<WorkflowService> workflowService,
+                                   size_t cacheCapacity = 256);
+
+    /**
+     * @brief An API prompt tagged with the workflow version it was built from
+     */
+    struct VersionedPrompt {
+        int64_t version = 0;
+        std::shared_ptr<const std::string> prompt;  // Serialized JSON object
+    };
+
+    /**
+     * @brief Returns the API prompt for the current version of a visible workflow
+     *
+     * @param workflowId The workflow to convert
+     * @param userId The caller
+     * @return The prompt or a WorkflowError (422 if the workflow cannot be converted)
+     */
+    std::expected<VersionedPrompt, WorkflowService::WorkflowError> getPrompt(
+        int64_t workflowId,
+        int64_t userId);
+
+    // Drops any cached prompt for a deleted workflow
+    void invalidate(int64_t workflowId);
+
+  private:
+    std::shared_ptr<WorkflowService> workflowService_;
+    graph::NodeSchemaRegistry schemas_;
+    utils::VersionedLruCache<std::string> cache_;
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
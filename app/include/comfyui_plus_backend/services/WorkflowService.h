@@ -0,0 +1,188 @@
+#pragma once
+
+#include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/db/models.h"
+#include "comfyui_plus_backend/models/Workflow.h"
+#include "comfyui_plus_backend/utils/WorkflowIngest.h"
+#include <expected>
+#include <string>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+/**
+ * @brief Service for storing and retrieving user workflows
+ *
+ * Workflow bodies arrive already validated by utils::WorkflowIngest. Each
+ * body is stored as two columns: the semantic graph in `json_data` and the
+ * editor layout in `layout_data` (see graph::splitLayout), so consumers that
+ * never render can skip the layout bytes entirely.
+ */
+class WorkflowService
+{
+  public:
+    WorkflowService();
+
+    /**
+     * @brief Error type for workflow operations
+     */
+    struct WorkflowError {
+        std::string message;
+        int statusCode;  // HTTP status code to return
+
+        WorkflowError(std::string msg, int code = 400)
+            : message(std::move(msg)), statusCode(code) {}
+    };
+
+    /**
+     * @brief Which stored body columns a read should load
+     */
+    enum class BodyParts {
+        Graph,   // json_data only
+        Layout,  // layout_data only
+        Both
+    };
+
+    /**
+     * @brief Creates a workflow owned by userId from a parsed upload
+     *
+     * @param userId The owner of the new workflow
+     * @param upload A payload parsed with json_data required
+     * @return The stored workflow or a WorkflowError
+     */
+    std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowError> createWorkflow(
+        int64_t userId,
+        const utils::WorkflowUpload &upload);
+
+    /**
+     * @brief Validates an upload and builds the row createWorkflow() would insert
+     *
+     * Owns copies of every field, so the upload's scratch buffer may be reused
+     * afterwards. Used to batch inserts, see insertWorkflows().
+     *
+     * @param userId The owner of the new workflow
+     * @param upload A payload parsed with json_data required
+     * @return A row without an id, or a WorkflowError
+     */
+    std::expected<comfyui_plus_backend::app::db::models::Workflow, WorkflowError> prepareNewWorkflow(
+        int64_t userId,
+        const utils::WorkflowUpload &upload);
+
+    /**
+     * @brief Inserts prepared rows in a single transaction
+     *
+     * All rows are stored or none are. On success each row's id is set.
+     *
+     * @param rows Rows from prepareNewWorkflow()
+     * @return Nothing on success, or a WorkflowError
+     */
+    std::expected<void, WorkflowError> insertWorkflows(
+        std::vector<comfyui_plus_backend::app::db::models::Workflow> &rows);
+
+    /**
+     * @brief Applies the fields present in upload to an existing workflow
+     *
+     * Every successful update increments the workflow's version.
+     *
+     * @param workflowId The workflow to update
+     * @param userId The caller, who must own the workflow
+     * @param upload A payload parsed with json_data optional
+     * @return The updated workflow or a WorkflowError
+     */
+    std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowError> updateWorkflow(
+        int64_t workflowId,
+        int64_t userId,
+        const utils::WorkflowUpload &upload);
+
+    /**
+     * @brief Fetches a workflow the caller owns or that is public
+     *
+     * The graph and layout are returned unmerged in json_data and layout_data;
+     * a part that was not requested is left empty.
+     *
+     * @param workflowId The workflow to fetch
+     * @param userId The caller
+     * @param parts The body columns to load
+     * @return The workflow including the requested body parts, or a WorkflowError
+     */
+    std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowError> getWorkflowById(
+        int64_t workflowId,
+        int64_t userId,
+        BodyParts parts = BodyParts::Both);
+
+    /**
+     * @brief Fetches the metadata row of a visible workflow without its body
+     *
+     * Cheap enough to call on every request to learn the current version.
+     *
+     * @param workflowId The workflow to fetch
+     * @param userId The caller
+     * @return The workflow with an empty json_data, or a WorkflowError
+     */
+    std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowError> getWorkflowMetadata(
+        int64_t workflowId,
+        int64_t userId);
+
+    /**
+     * @brief Lists the caller's workflows without loading their bodies
+     *
+     * @param userId The owner whose workflows are listed
+     * @return Workflow summaries ordered by id, or a WorkflowError
+     */
+    std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowError>
+    listWorkflowsByUser(int64_t userId);
+
+    /**
+     * @brief Lists one page of the caller's workflows, keyed on id
+     *
+     * Keyset pagination: each page seeks past afterId on the rowid, so
+     * streaming a long listing never re-reads earlier rows.
+     *
+     * @param userId The owner whose workflows are listed
+     * @param afterId Only workflows with a greater id are returned; 0 for the first page
+     * @param limit Maximum number of summaries to return
+     * @return Workflow summaries ordered by id, or a WorkflowError
+     */
+    std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowError>
+    listWorkflowsPage(int64_t userId, int64_t afterId, int limit);
+
+    /**
+     * @brief Like listWorkflowsPage() but with each graph and layout loaded
+     *
+     * Used for bulk export; keep limit small, since each row carries its body.
+     *
+     * @param userId The owner whose workflows are read
+     * @param afterId Only workflows with a greater id are returned; 0 for the first page
+     * @param limit Maximum number of workflows to return
+     * @return Workflows with unmerged json_data and layout_data, ordered by id, or a WorkflowError
+     */
+    std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowError>
+    listWorkflowBodiesPage(int64_t userId, int64_t afterId, int limit);
+
+    /**
+     * @brief Deletes a workflow, its tag associations and its precompressed bodies
+     *
+     * @param workflowId The workflow to delete
+     * @param userId The caller, who must own the workflow
+     * @return Nothing on success, or a WorkflowError
+     */
+    std::expected<void, WorkflowError> deleteWorkflow(int64_t workflowId, int64_t userId);
+
+    // Converts a DB model to the application's Workflow model, consuming the body
+    comfyui_plus_backend::app::models::Workflow dbModelToWorkflowModel(
+        comfyui_plus_backend::app::db::models::Workflow &&dbWorkflow);
+
+  private:
+    // Access to the database storage
+    db::DatabaseManager& dbManager_;
+
+};
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,89 @@
+// app/include/comfyui_plus_backend/utils/AsyncLogWriter.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Moves log output off the threads that log
+ *
+ * Installed as trantor's output function, so it carries Drogon's records
+ * as well as ours. Each formatted record is copied into a bounded lock-free
+ * ring and written to stdout by one background thread. When the ring is full
+ * the record is dropped and counted rather than blocking an I/O loop.
+ *
+ * With Format::Json each record becomes one JSON object per line:
+ *
+ *     {"ts":"20261018 09:14:02.381204","tid":"4821","level":"WARN","msg":"...","src":"JwtAuthFilter.cc:50"}
+ */
+class AsyncLogWriter
+{
+public:
+    enum class Format {
+        Text, // trantor's line, unchanged
+        Json
+    };
+
+    // Routes all logging through a writer with room for `capacity` records
+    // (rounded up to a power of two). Call once, before the app runs.
+    static void start(size_t capacity, Format format);
+
+    // Writes out what is queued and restores trantor's synchronous output
+    static void stop();
+
+    // Records lost to a full ring since start()
+    static uint64_t dropped();
+
+    // Converts one trantor-formatted line to a JSON object line. Lines that
+    // do not parse are kept whole in "msg".
+    static void appendJson(std::string &out, std::string_view line);
+
+    ~AsyncLogWriter();
+
+private:
+    AsyncLogWriter(size_t capacity, Format format);
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    bool push(const char *data, size_t length);
+    void run();
+    void drain(std::string &batch);
+    void flush();
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::string record;
+    };
+
+    const Format format_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(64) std::atomic<size_t> tail_{0}; // Producers claim cells here
+    alignas(64) size_t head_ = 0;             // Writer thread only
+    uint64_t reportedDrops_ = 0;              // Writer thread only
+    alignas(64) std::atomic<uint32_t> pending_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::thread thread_;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
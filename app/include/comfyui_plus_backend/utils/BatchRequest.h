@@ -0,0 +1,43 @@
+// app/include/comfyui_plus_backend/utils/BatchRequest.h
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief One sub-request of a POST /batch body
+ */
+struct BatchItem {
+    std::string method;  // Upper case, e.g. "GET"
+    std::string path;    // May carry a query string
+    std::string body;    // The raw JSON of "body", or empty when absent
+};
+
+/**
+ * @brief Parser for POST /batch bodies
+ *
+ * The body has the form {"requests": [{"method", "path", "body"}, ...]}. Each
+ * sub-request body is kept as the raw bytes the client sent, so it reaches the
+ * target handler exactly as a standalone request would.
+ */
+class BatchRequest
+{
+  public:
+    // Returns the sub-requests in order, or a client-facing error message
+    static std::expected<std::vector<BatchItem>, std::string> parse(std::string_view body,
+                                                                   size_t maxItems);
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,50 @@
+// app/include/comfyui_plus_backend/utils/BloomFilter.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Fixed-size Bloom filter over strings, safe for concurrent add and lookup
+ *
+ * mightContain() returning false is definite: the string was never added.
+ * True may be a false positive, at roughly the rate the filter was sized for
+ * while it holds no more than expectedItems strings. Bits are set with atomic
+ * ORs, so lookups never wait for an add.
+ */
+class BloomFilter
+{
+public:
+    BloomFilter(size_t expectedItems, double falsePositiveRate);
+
+    void add(std::string_view item);
+    bool mightContain(std::string_view item) const;
+
+    size_t bitCount() const { return wordCount_ * 64; }
+    size_t hashCount() const { return hashCount_; }
+    size_t expectedItems() const { return expectedItems_; }
+
+private:
+    // Two independent 64-bit hashes; probe i is h1 + i * h2 (Kirsch-Mitzenmacher)
+    static std::pair<uint64_t, uint64_t> hash(std::string_view item);
+
+    size_t expectedItems_;
+    size_t wordCount_;
+    size_t hashCount_;
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
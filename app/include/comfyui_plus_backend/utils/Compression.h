@@ -0,0 +1,36 @@
+// app/include/comfyui_plus_backend/utils/Compression.h
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief One-shot compression into HTTP Content-Encoding formats
+ *
+ * Intended for bodies that are compressed once and served many times, so
+ * the defaults favour ratio over speed.
+ */
+class Compression
+{
+public:
+    // RFC 1952 gzip stream; nullopt on failure
+    static std::optional<std::string> gzip(std::string_view input, int level = 9);
+
+    // Brotli stream; nullopt on failure or when built without brotli
+    static std::optional<std::string> brotli(std::string_view input, int quality = 9);
+
+    // Whether brotli() can succeed in this build
+    static bool brotliAvailable();
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,72 @@
+// app/include/comfyui_plus_backend/utils/ConcurrencyLimiter.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Caps requests in flight at a limit that follows observed latency
+ *
+ * AIMD: a request that finishes within the target latency adds 1/limit to
+ * the limit, so it grows by about one per limit's worth of completions, and
+ * only while at least half of it is in use. A request slower than the target
+ * multiplies the limit by the backoff, at most once per that request's
+ * latency, since requests finishing sooner were admitted under the old limit.
+ *
+ * tryAcquire() is a compare-and-swap on the in-flight count. release()
+ * updates the limit under a mutex it only tries to take; a sample that
+ * finds it held is dropped rather than waited for.
+ */
+class ConcurrencyLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        size_t initialLimit = 32;
+        size_t minLimit = 2;
+        size_t maxLimit = 512;
+        uint64_t targetLatencyMicros = 250'000;
+        double backoff = 0.9; // Limit multiplier when a request is too slow
+    };
+
+    explicit ConcurrencyLimiter(const Settings &settings);
+
+    ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+    ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+    // Admits a request if fewer than limit() are in flight
+    bool tryAcquire();
+
+    // Ends a request admitted by tryAcquire() and feeds its latency back
+    void release(uint64_t latencyMicros, Clock::time_point now = Clock::now());
+
+    size_t limit() const { return limit_.load(std::memory_order_relaxed); }
+    size_t inFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+    uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    const Settings settings_;
+
+    alignas(64) std::atomic<size_t> inFlight_{0};
+    std::atomic<size_t> limit_;
+    std::atomic<uint64_t> rejected_{0};
+
+    alignas(64) std::mutex mutex_;
+    double exactLimit_;            // Guarded by mutex_; limit_ is its floor
+    Clock::time_point nextDecrease_{};
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
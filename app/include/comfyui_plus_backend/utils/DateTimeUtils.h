@@ -34,6 +34,11 @@ public:
         }
     }
     
+    // Format a trantor::Date as an ISO-8601 UTC string for API responses
+    static std::string dateToIsoString(const trantor::Date &date) {
+        return date.toCustomedFormattedString("%Y-%m-%dT%H:%M:%SZ");
+    }
+
     // Convert a chrono time_point to trantor::Date
     template<typename Clock, typename Duration>
     static trantor::Date timePointToDate(const std::chrono::time_point<Clock, Duration>& tp) {
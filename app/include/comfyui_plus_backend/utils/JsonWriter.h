@@ -0,0 +1,93 @@
+// app/include/comfyui_plus_backend/utils/JsonWriter.h
+#pragma once
+
+#include <drogon/HttpResponse.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Append-only JSON serializer writing straight into a response body
+ *
+ * Replaces building a Json::Value tree and serializing it afterwards: each
+ * call appends its bytes to one buffer, which is moved into the response
+ * without a copy. Stored JSON (workflow bodies) is spliced in with raw().
+ * Commas are inserted automatically; callers only balance begin/end calls.
+ *
+ *     JsonWriter json;
+ *     json.beginObject().field("message", "ok").key("workflow").raw(stored).endObject();
+ *     callback(std::move(json).toResponse());
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(size_t reserveBytes = 256) { buffer_.reserve(reserveBytes); }
+
+    JsonWriter& beginObject() { separate(); buffer_.push_back('{'); needsComma_ = false; return *this; }
+    JsonWriter& endObject() { buffer_.push_back('}'); needsComma_ = true; return *this; }
+    JsonWriter& beginArray() { separate(); buffer_.push_back('['); needsComma_ = false; return *this; }
+    JsonWriter& endArray() { buffer_.push_back(']'); needsComma_ = true; return *this; }
+
+    // Writes an object key; the next call writes its value
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char *text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string &text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(uint64_t number);
+    JsonWriter& value(double number); // Non-finite values are written as null
+    JsonWriter& null();
+
+    // Splices an already-serialized JSON value verbatim
+    JsonWriter& raw(std::string_view json);
+
+    // Ends a top-level value with a newline, for NDJSON output
+    JsonWriter& endLine() { buffer_.push_back('\n'); needsComma_ = false; return *this; }
+
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T &fieldValue)
+    {
+        key(name);
+        return value(fieldValue);
+    }
+
+    const std::string& buffer() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+
+    // Drops the bytes written so far but keeps the comma state, so a
+    // streamed document can be emitted in chunks from one writer
+    void clearBuffer() { buffer_.clear(); }
+
+    std::string take() && { return std::move(buffer_); }
+
+    // Moves the buffer into a JSON response; the body is never copied
+    drogon::HttpResponsePtr toResponse(drogon::HttpStatusCode status = drogon::k200OK) &&;
+
+    // Appends text as a quoted, escaped JSON string
+    static void appendEscaped(std::string& out, std::string_view text);
+
+private:
+    void separate()
+    {
+        if (needsComma_) {
+            buffer_.push_back(',');
+        }
+    }
+
+    std::string buffer_;
+    bool needsComma_ = false;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,108 @@
+// app/include/comfyui_plus_backend/utils/LoadShedder.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/ConcurrencyLimiter.h"
+#include <drogon/HttpRequest.h>
+#include <drogon/HttpResponse.h>
+#include <json/json.h>
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Turns requests away with 503 once a class of routes is saturated
+ *
+ * Auth, workflow reads and workflow writes each have a ConcurrencyLimiter.
+ * A request is admitted in pre-routing advice, before any filter, parse or
+ * query runs, and holds its permit until its response leaves, or until a
+ * streamed body ends (holdPermit()); the time to the response is the latency
+ * its limiter adapts to. Past saturation the extra
+ * requests cost one compare-and-swap and a small response, so the ones
+ * admitted keep their latency instead of every request queueing behind
+ * every other. Health and metrics routes are never limited.
+ *
+ *     "load_shedding": {
+ *         "enabled": true,
+ *         "backoff": 0.9,
+ *         "auth": {"target_latency_ms": 250, "initial_limit": 16, "min_limit": 2, "max_limit": 256},
+ *         "workflow_read": {...},
+ *         "workflow_write": {...}
+ *     }
+ */
+class LoadShedder
+{
+public:
+    enum class RouteClass : size_t {
+        Auth,
+        WorkflowRead,
+        WorkflowWrite,
+        Count_
+    };
+    static constexpr size_t kClassCount = static_cast<size_t>(RouteClass::Count_);
+
+    struct Settings {
+        bool enabled = true;
+        std::array<ConcurrencyLimiter::Settings, kClassCount> classes = {
+            ConcurrencyLimiter::Settings{16, 2, 256, 250'000},
+            ConcurrencyLimiter::Settings{64, 4, 1024, 100'000},
+            ConcurrencyLimiter::Settings{32, 4, 512, 250'000}};
+    };
+
+    // Reads `load_shedding`; a null section gives the defaults. Returns a
+    // message naming the bad key.
+    static std::expected<Settings, std::string> settingsFromConfig(const Json::Value &section);
+
+    // The config key and metric label, e.g. "workflow_read"
+    static std::string_view className(RouteClass routeClass);
+
+    // Which limiter a request counts against; nullopt for unlimited routes
+    static std::optional<RouteClass> classify(drogon::HttpMethod method, std::string_view path);
+
+    // Get the singleton instance
+    static LoadShedder& getInstance();
+
+    // Replaces the limiters; call before the app runs
+    void configure(const Settings &settings);
+
+    // Admits the request or returns false; an admitted request holds a
+    // permit in its attributes until finish() or its destruction
+    bool admit(const drogon::HttpRequestPtr &req);
+
+    // Releases the request's permit, if it has one, and records its latency
+    static void finish(const drogon::HttpRequestPtr &req);
+
+    // For a body streamed after the handler returns: finish() leaves the
+    // permit alone, and it is released when the returned handle goes.
+    // Returns null if the request holds no permit.
+    static std::shared_ptr<void> holdPermit(const drogon::HttpRequestPtr &req);
+
+    // 503 with Retry-After, for requests admit() turned away
+    static drogon::HttpResponsePtr overloadedResponse();
+
+    bool enabled() const { return enabled_; }
+    const ConcurrencyLimiter& limiter(RouteClass routeClass) const;
+
+private:
+    LoadShedder();
+
+    LoadShedder(const LoadShedder&) = delete;
+    LoadShedder& operator=(const LoadShedder&) = delete;
+
+    bool enabled_ = false;
+    std::array<std::unique_ptr<ConcurrencyLimiter>, kClassCount> limiters_;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
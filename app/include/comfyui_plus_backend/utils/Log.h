@@ -0,0 +1,48 @@
+// app/include/comfyui_plus_backend/utils/Log.h
+#pragma once
+
+#include <trantor/utils/Logger.h>
+
+/**
+ * Drogon's LOG_TRACE/DEBUG/INFO/WARN with a compile-time floor
+ *
+ * Statements below COMFYUI_PLUS_MIN_LOG_LEVEL are discarded at compile time,
+ * operands included; the rest check the runtime level (app.log_level in
+ * config.json) before anything is formatted, as Drogon's macros do. Levels:
+ * 0 trace, 1 debug, 2 info, 3 warn. Release builds default to 2. Include
+ * this in every file that logs; it must win over trantor/utils/Logger.h.
+ */
+#ifndef COMFYUI_PLUS_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define COMFYUI_PLUS_MIN_LOG_LEVEL 2
+#else
+#define COMFYUI_PLUS_MIN_LOG_LEVEL 0
+#endif
+#endif
+
+#define COMFYUI_PLUS_LOG_IF_(level)                                    \
+    if constexpr (static_cast<int>(level) < COMFYUI_PLUS_MIN_LOG_LEVEL) \
+    {                                                                   \
+    }                                                                   \
+    else if (trantor::Logger::logLevel() > (level))                     \
+    {                                                                   \
+    }                                                                   \
+    else
+
+#undef LOG_TRACE
+#undef LOG_DEBUG
+#undef LOG_INFO
+#undef LOG_WARN
+
+#define LOG_TRACE                                      \
+    COMFYUI_PLUS_LOG_IF_(trantor::Logger::kTrace)      \
+    trantor::Logger(__FILE__, __LINE__, trantor::Logger::kTrace, __func__).stream()
+#define LOG_DEBUG                                      \
+    COMFYUI_PLUS_LOG_IF_(trantor::Logger::kDebug)      \
+    trantor::Logger(__FILE__, __LINE__, trantor::Logger::kDebug, __func__).stream()
+#define LOG_INFO                                       \
+    COMFYUI_PLUS_LOG_IF_(trantor::Logger::kInfo)       \
+    trantor::Logger(__FILE__, __LINE__).stream()
+#define LOG_WARN                                       \
+    COMFYUI_PLUS_LOG_IF_(trantor::Logger::kWarn)       \
+    trantor::Logger(__FILE__, __LINE__, trantor::Logger::kWarn).stream()
@@ -0,0 +1,67 @@
+// app/include/comfyui_plus_backend/utils/Metrics.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Process metrics, rendered in the Prometheus text format by GET /metrics
+ *
+ * Every thread updates its own cache-line-aligned block with plain loads and
+ * stores, so recording costs a few nanoseconds and never contends with other
+ * threads. A scrape sums the blocks; a value read mid-update is at most one
+ * event behind. Blocks live as long as the process, so counts never go back.
+ */
+class Metrics
+{
+public:
+    enum class Counter : size_t {
+        JwtVerifications,
+        JwtVerificationFailures,
+        PasswordHashes,
+        PasswordVerifications,
+        DbQueries,
+        DbQueryNanos,
+        DbWorkerTasks,
+        DbWorkerWaitNanos,
+        PasswordHashTasks,
+        PasswordHashWaitNanos,
+        RequestsStarted,
+        RateLimitedByIp,
+        RateLimitedByAccount,
+        Count_
+    };
+
+    static void increment(Counter counter, uint64_t by = 1);
+
+    // Records a finished request. `route` is the matched path pattern, e.g.
+    // "/workflows/{id}", so ids do not create a series each.
+    static void recordRequest(std::string_view method,
+                              std::string_view route,
+                              int statusCode,
+                              uint64_t latencyMicros);
+
+    // Prometheus text exposition format, version 0.0.4
+    static std::string render();
+
+    // Upper bounds of the latency histogram buckets in microseconds,
+    // 1-2.5-5 steps from 100 us to 10 s; +Inf follows the last
+    static constexpr uint64_t kLatencyBucketsMicros[] = {
+        100, 250, 500, 1'000, 2'500, 5'000, 10'000, 25'000, 50'000,
+        100'000, 250'000, 500'000, 1'000'000, 2'500'000, 5'000'000, 10'000'000};
+    static constexpr size_t kLatencyBucketCount = std::size(kLatencyBucketsMicros) + 1;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,32 @@
+// app/include/comfyui_plus_backend/utils/PasswordHashPool.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/WorkerPool.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Worker threads for Argon2 hashing and verification
+ *
+ * Each PasswordUtils call takes tens of milliseconds and 64 MiB, so the
+ * auth handlers run here instead of on an I/O loop. The thread count,
+ * `threads.password_hash_workers` in config.json, bounds both.
+ */
+class PasswordHashPool : public WorkerPool
+{
+public:
+    // Get the singleton instance
+    static PasswordHashPool& getInstance();
+
+private:
+    PasswordHashPool();
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,87 @@
+// app/include/comfyui_plus_backend/utils/RateLimiter.h
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Token buckets keyed by client IP, account name or similar
+ *
+ * Buckets are split across lock-striped shards by key hash. A bucket is
+ * refilled lazily when its key is next seen, so idle keys cost nothing. A
+ * bucket that would have refilled to the burst is the same as no bucket, and
+ * evictIdle() drops those. Each shard holds at most maxKeys / shard count
+ * buckets; when a full shard has nothing idle to drop, a new key is refused,
+ * so a flood of distinct keys cannot grow memory without bound.
+ */
+class RateLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limit {
+        double tokensPerSecond = 1.0;
+        double burst = 10.0; // Requests allowed at once from a full bucket
+    };
+
+    struct Decision {
+        bool allowed = true;
+        double retryAfterSeconds = 0; // Until a token is available; 0 when allowed
+    };
+
+    RateLimiter(Limit limit, size_t maxKeys);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Takes one token from the key's bucket if it has one
+    Decision tryAcquire(std::string_view key, Clock::time_point now = Clock::now());
+
+    // Drops buckets that have refilled; returns how many. Call periodically.
+    size_t evictIdle(Clock::time_point now = Clock::now());
+
+    size_t size() const;
+
+private:
+    static constexpr size_t kShardCount = 64;
+
+    struct Bucket {
+        double tokens;
+        Clock::time_point updated;
+    };
+
+    // Lets find() take a string_view without building a std::string
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Bucket, KeyHash, std::equal_to<>> buckets;
+    };
+
+    double refilled(const Bucket &bucket, Clock::time_point now) const;
+    size_t evictIdle(Shard &shard, Clock::time_point now);
+
+    const Limit limit_;
+    const size_t maxKeysPerShard_;
+    std::array<Shard, kShardCount> shards_;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
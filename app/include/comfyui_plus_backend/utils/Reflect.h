@@ -0,0 +1,100 @@
+// app/include/comfyui_plus_backend/utils/Reflect.h
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+namespace reflect
+{
+
+/**
+ * @brief Compile-time description of one serialized field
+ *
+ * The accessor is either a data member pointer, which makes the field
+ * readable and writable, or a const getter, which makes it write-only.
+ * Sensitive fields are part of the type, so serializers drop them with
+ * `if constexpr` and no code is emitted for them.
+ *
+ * String fields may carry length bounds, which readers enforce while the
+ * body is being parsed:
+ *
+ *     reflect::field("username", &RegisterRequest::username).length(3, 64)
+ */
+template <typename Accessor, bool Sensitive>
+struct Field {
+    std::string_view name;
+    Accessor accessor;
+    size_t minLength = 0;
+    size_t maxLength = 0;  // 0 for unbounded
+
+    static constexpr bool sensitive = Sensitive;
+    static constexpr bool assignable = std::is_member_object_pointer_v<Accessor>;
+
+    // Bounds in UTF-8 code points
+    constexpr Field length(size_t min, size_t max) const
+    {
+        Field bounded = *this;
+        bounded.minLength = min;
+        bounded.maxLength = max;
+        return bounded;
+    }
+};
+
+template <typename Accessor>
+constexpr auto field(std::string_view name, Accessor accessor)
+{
+    return Field<Accessor, false>{name, accessor};
+}
+
+// Readable from requests but never written to a response
+template <typename Accessor>
+constexpr auto sensitiveField(std::string_view name, Accessor accessor)
+{
+    return Field<Accessor, true>{name, accessor};
+}
+
+template <typename... Fields>
+constexpr auto fields(Fields... descriptors)
+{
+    return std::tuple<Fields...>{descriptors...};
+}
+
+/**
+ * @brief Types that list their fields, in the spirit of sqlite_orm's make_column
+ *
+ *     static constexpr auto jsonFields()
+ *     {
+ *         return reflect::fields(reflect::field("id", &Tag::id), reflect::field("name", &Tag::name));
+ *     }
+ */
+template <typename T>
+concept Described = requires { T::jsonFields(); };
+
+// Request DTOs may also cap the whole body, checked before any parsing:
+//     static constexpr size_t maxJsonBytes = 4096;
+template <typename T>
+concept SizeCapped = requires { { T::maxJsonBytes } -> std::convertible_to<size_t>; };
+
+// Calls fn(field, std::integral_constant<size_t, I>) for every descriptor, unrolled
+template <typename Tuple, typename Fn>
+constexpr void forEachField(const Tuple &descriptors, Fn &&fn)
+{
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn(std::get<I>(descriptors), std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+}
+
+} // namespace reflect
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
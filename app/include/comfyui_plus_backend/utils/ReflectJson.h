@@ -0,0 +1,299 @@
+// app/include/comfyui_plus_backend/utils/ReflectJson.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/DateTimeUtils.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include "comfyui_plus_backend/utils/Reflect.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include "comfyui_plus_backend/utils/Utf8.h"
+#include <simdjson.h>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+namespace reflect
+{
+
+namespace detail
+{
+
+template <typename T>
+struct IsOptional : std::false_type {};
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct IsVector : std::false_type {};
+template <typename T>
+struct IsVector<std::vector<T>> : std::true_type {};
+
+// Per-thread On-Demand parser over a padded copy of the input
+simdjson::ondemand::parser &threadParser();
+simdjson::padded_string_view padThreadBuffer(std::string_view input);
+
+} // namespace detail
+
+template <Described T>
+void writeMembers(JsonWriter &json, const T &object);
+
+template <typename T>
+void writeValue(JsonWriter &json, const T &value)
+{
+    if constexpr (Described<T>) {
+        json.beginObject();
+        writeMembers(json, value);
+        json.endObject();
+    } else if constexpr (detail::IsOptional<T>::value) {
+        if (value) {
+            writeValue(json, *value);
+        } else {
+            json.null();
+        }
+    } else if constexpr (detail::IsVector<T>::value) {
+        json.beginArray();
+        for (const auto &element : value) {
+            writeValue(json, element);
+        }
+        json.endArray();
+    } else if constexpr (std::is_same_v<T, trantor::Date>) {
+        json.value(DateTimeUtils::dateToIsoString(value));
+    } else {
+        json.value(value);
+    }
+}
+
+// Writes the described fields into the currently open object
+template <Described T>
+void writeMembers(JsonWriter &json, const T &object)
+{
+    static constexpr auto descriptors = T::jsonFields();
+    forEachField(descriptors, [&](const auto &field, auto) {
+        if constexpr (!std::remove_cvref_t<decltype(field)>::sensitive) {
+            json.key(field.name);
+            writeValue(json, std::invoke(field.accessor, object));
+        }
+    });
+}
+
+template <Described T>
+std::string toJson(const T &object, size_t reserveBytes = 256)
+{
+    JsonWriter json(reserveBytes);
+    writeValue(json, object);
+    return std::move(json).take();
+}
+
+/**
+ * @brief Why a request body could not be read into a described type
+ */
+struct ReadError {
+    enum class Kind {
+        TooLarge,      // The body exceeds the type's maxJsonBytes
+        InvalidJson,
+        MissingField,  // A non-optional field was absent
+        WrongType,
+        TooShort,
+        TooLong
+    };
+
+    Kind kind;
+    std::string_view field;  // Empty for TooLarge and InvalidJson
+    size_t limit = 0;        // The violated bound, for the size and length kinds
+
+    std::string message() const;
+};
+
+namespace detail
+{
+
+// Checks a string member, or a present optional string, against its bounds
+template <typename Descriptor, typename Member>
+std::optional<ReadError> checkLength(const Descriptor &field, const Member &member)
+{
+    if constexpr (std::is_same_v<Member, std::string> || std::is_same_v<Member, std::optional<std::string>>) {
+        const std::string *text = nullptr;
+        if constexpr (std::is_same_v<Member, std::string>) {
+            text = &member;
+        } else if (member) {
+            text = &*member;
+        }
+        if (text == nullptr) {
+            return std::nullopt;
+        }
+        // The byte length bounds the code point count from above, so most
+        // strings never need counting
+        if (field.maxLength != 0 && text->size() > field.maxLength &&
+            utf8Length(*text) > field.maxLength) {
+            return ReadError{ReadError::Kind::TooLong, field.name, field.maxLength};
+        }
+        if (field.minLength != 0 && (text->size() < field.minLength || utf8Length(*text) < field.minLength)) {
+            return ReadError{ReadError::Kind::TooShort, field.name, field.minLength};
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace detail
+
+template <Described T>
+std::optional<ReadError> readMembers(simdjson::ondemand::object object, T &out);
+
+template <typename T>
+bool readValue(simdjson::ondemand::value value, T &out)
+{
+    if constexpr (Described<T>) {
+        simdjson::ondemand::object object;
+        return !value.get_object().get(object) && !readMembers(object, out);
+    } else if constexpr (detail::IsOptional<T>::value) {
+        bool isNull = false;
+        if (value.is_null().get(isNull)) {
+            return false;
+        }
+        if (isNull) {
+            out.reset();
+            return true;
+        }
+        typename T::value_type inner{};
+        if (!readValue(value, inner)) {
+            return false;
+        }
+        out = std::move(inner);
+        return true;
+    } else if constexpr (detail::IsVector<T>::value) {
+        simdjson::ondemand::array array;
+        if (value.get_array().get(array)) {
+            return false;
+        }
+        out.clear();
+        for (auto elementResult : array) {
+            simdjson::ondemand::value element;
+            if (elementResult.get(element) || !readValue(element, out.emplace_back())) {
+                return false;
+            }
+        }
+        return true;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        std::string_view text;
+        if (value.get_string().get(text)) {
+            return false;
+        }
+        out.assign(text);
+        return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return !value.get_bool().get(out);
+    } else if constexpr (std::is_integral_v<T>) {
+        int64_t number = 0;
+        if (value.get_int64().get(number)) {
+            return false;
+        }
+        out = static_cast<T>(number);
+        return true;
+    } else {
+        static_assert(std::is_floating_point_v<T>, "Unsupported field type");
+        double number = 0;
+        if (value.get_double().get(number)) {
+            return false;
+        }
+        out = static_cast<T>(number);
+        return true;
+    }
+}
+
+// Assigns every described data member present in object, validating each
+// against its descriptor as it is read; the first violation stops the parse.
+// Unknown keys are skipped; getter-only fields are never read.
+template <Described T>
+std::optional<ReadError> readMembers(simdjson::ondemand::object object, T &out)
+{
+    static constexpr auto descriptors = T::jsonFields();
+    std::array<bool, std::tuple_size_v<decltype(descriptors)>> seen{};
+
+    for (auto fieldResult : object) {
+        simdjson::ondemand::field jsonField;
+        if (std::move(fieldResult).get(jsonField)) {
+            return ReadError{ReadError::Kind::InvalidJson, {}};
+        }
+        std::string_view key = jsonField.escaped_key();
+
+        std::optional<ReadError> error;
+        forEachField(descriptors, [&](const auto &field, auto index) {
+            if constexpr (std::remove_cvref_t<decltype(field)>::assignable) {
+                if (!seen[index] && field.name == key) {
+                    seen[index] = true;
+                    if (!readValue(jsonField.value(), out.*field.accessor)) {
+                        error = ReadError{ReadError::Kind::WrongType, field.name};
+                    } else {
+                        error = detail::checkLength(field, out.*field.accessor);
+                    }
+                }
+            }
+        });
+        if (error) {
+            return error;
+        }
+    }
+
+    std::optional<ReadError> missing;
+    forEachField(descriptors, [&](const auto &field, auto index) {
+        using Descriptor = std::remove_cvref_t<decltype(field)>;
+        if constexpr (Descriptor::assignable) {
+            using Member = std::remove_cvref_t<decltype(out.*field.accessor)>;
+            if (!detail::IsOptional<Member>::value && !seen[index] && !missing) {
+                missing = ReadError{ReadError::Kind::MissingField, field.name};
+            }
+        }
+    });
+    return missing;
+}
+
+/**
+ * @brief Parses and validates a JSON object body straight into a described type
+ *
+ * Fields are matched against the compile-time descriptor list while
+ * simdjson walks the document once, so no intermediate DOM is built.
+ * Oversized bodies are rejected before parsing starts, and type or length
+ * violations stop the walk at the offending field.
+ */
+template <Described T>
+std::expected<T, ReadError> fromJson(std::string_view body)
+{
+    RequestTrace::Phase phase("parse.json");
+
+    if constexpr (SizeCapped<T>) {
+        if (body.size() > T::maxJsonBytes) {
+            return std::unexpected(ReadError{ReadError::Kind::TooLarge, {}, T::maxJsonBytes});
+        }
+    }
+
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::object object;
+    if (detail::threadParser().iterate(detail::padThreadBuffer(body)).get(doc) ||
+        doc.get_object().get(object)) {
+        return std::unexpected(ReadError{ReadError::Kind::InvalidJson, {}});
+    }
+
+    T result{};
+    if (auto error = readMembers(object, result)) {
+        return std::unexpected(*error);
+    }
+    if (!doc.at_end()) {
+        return std::unexpected(ReadError{ReadError::Kind::InvalidJson, {}});
+    }
+    return result;
+}
+
+} // namespace reflect
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
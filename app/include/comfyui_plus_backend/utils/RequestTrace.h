@@ -0,0 +1,121 @@
+// app/include/comfyui_plus_backend/utils/RequestTrace.h
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Where the time of one request went, phase by phase
+ *
+ * A trace is created when a request arrives and made current on the thread
+ * handling it. Code anywhere below (filter, controller, service, database)
+ * times itself with a Phase; without a current trace that costs one
+ * thread-local read. Work handed to DbWorkerPool or PasswordHashPool carries
+ * the trace along; other queues use Scope to do the same.
+ *
+ * When the response leaves, finish() logs one line with the per-phase
+ * totals if the request took longer than `tracing.slow_request_ms`, and
+ * appends the trace as OpenTelemetry JSON to `tracing.otel_file` when set:
+ *
+ *     "tracing": {"enabled": true, "slow_request_ms": 1000, "otel_file": ""}
+ */
+class RequestTrace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RequestTrace();
+
+    // Records a phase; phase must be a string literal. Thread-safe, since a
+    // batch fans its reads out to several workers at once.
+    void record(const char *phase, Clock::time_point start, Clock::time_point end);
+
+    // Ends the trace: the slow-request log line and the export happen here.
+    // Phases recorded afterwards are dropped.
+    void finish(std::string_view method, std::string_view route, int statusCode);
+
+    // Whether requests are traced at all; `tracing.enabled`, default true
+    static bool enabled();
+
+    // The trace of the request this thread is working on, or null. On an I/O
+    // loop it is set for the synchronous dispatch of a request only.
+    static const std::shared_ptr<RequestTrace> &current();
+    static void setCurrent(std::shared_ptr<RequestTrace> trace);
+
+    /**
+     * @brief Makes a trace current for the lifetime of the scope
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(std::shared_ptr<RequestTrace> trace);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::shared_ptr<RequestTrace> previous_;
+    };
+
+    /**
+     * @brief Times the enclosing block as a phase of the current request
+     */
+    class Phase
+    {
+    public:
+        explicit Phase(const char *name)
+            : trace_(current().get()), name_(name), start_(trace_ ? Clock::now() : Clock::time_point())
+        {
+        }
+        ~Phase() { end(); }
+
+        // Ends the phase early; needed before a response is handed to its
+        // callback, since that finishes the trace
+        void end()
+        {
+            if (trace_) {
+                trace_->record(name_, start_, Clock::now());
+                trace_ = nullptr;
+            }
+        }
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        RequestTrace *trace_;
+        const char *name_;
+        Clock::time_point start_;
+    };
+
+private:
+    struct Span {
+        const char *phase;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    Clock::time_point start_;
+    std::chrono::system_clock::time_point wallStart_;
+
+    std::mutex mutex_;
+    std::vector<Span> spans_;
+    bool finished_ = false;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,83 @@
+// app/include/comfyui_plus_backend/utils/ThreadTopology.h
+#pragma once
+
+#include <json/json.h>
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Size and CPU placement of one group of threads
+ */
+struct PoolTopology {
+    size_t threads = 0;
+    std::vector<unsigned> cpus; // Empty: the scheduler decides
+};
+
+/**
+ * @brief How many threads each pool runs and where, from the `threads`
+ * section of config.json
+ *
+ *     "threads": {
+ *         "io_threads": 0,             // Drogon event loops; 0 = one per hardware thread
+ *         "db_workers": 0,             // db::DbWorkerPool; 0 = 2..8 by core count
+ *         "password_hash_workers": 0,  // Argon2 pool; 0 = half the cores, 1..4
+ *         "batch_workers": 0,          // POST /batch coordinators; 0 = 2
+ *         "import_workers": 0,         // POST /workflows/import; 0 = 1
+ *         "encode_workers": 0,         // Precompression of stored bodies; 0 = 1
+ *         "pin_threads": false,        // true: thread i runs only on cpus[i % n]
+ *         "cpu_affinity": {"io": [], "db_workers": [], "password_hash_workers": [], ...}
+ *     }
+ *
+ * Every key is optional. A CPU list restricts its pool to those CPUs; with
+ * pin_threads each thread gets a single CPU from the list instead. The
+ * trace export thread is not listed: it appends to one file, in order.
+ */
+struct ThreadTopology {
+    PoolTopology io;
+    PoolTopology dbWorkers;
+    PoolTopology passwordHashWorkers;
+    PoolTopology batchWorkers;
+    PoolTopology importWorkers;
+    PoolTopology encodeWorkers;
+    bool pinThreads = false;
+
+    // Parses and validates the section; zero or missing counts become
+    // defaults for this machine. Returns a message naming the bad key.
+    static std::expected<ThreadTopology, std::string> fromConfig(const Json::Value &section);
+
+    // Hardware threads available, at least 1
+    static size_t hardwareThreads();
+
+    // The topology the app was started with; defaults until setActive()
+    static const ThreadTopology &active();
+    static void setActive(ThreadTopology topology);
+
+    // Restricts the calling thread to cpus, or to cpus[index % size] when
+    // pinning. Does nothing for an empty list; false if the OS refused.
+    static bool applyAffinity(const std::vector<unsigned> &cpus, size_t index, bool pin);
+
+    // Runs applyAffinity() once on each thread of a task queue
+    static void applyAffinity(trantor::ConcurrentTaskQueue &queue, const PoolTopology &pool, bool pin);
+
+    // Queues one task per thread so each of the queue's `threads` threads runs
+    // task exactly once; task gets the thread's index. The threads wait for
+    // each other, so nothing else runs on the queue until all have started.
+    static void runOnEachThread(trantor::ConcurrentTaskQueue &queue,
+                                size_t threads,
+                                std::function<void(size_t)> task);
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,27 @@
+// app/include/comfyui_plus_backend/utils/Utf8.h
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+// Code points in a UTF-8 string simdjson has already validated; what the
+// "characters" in a length limit's message count
+inline size_t utf8Length(std::string_view text)
+{
+    size_t count = 0;
+    for (char ch : text) {
+        count += (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
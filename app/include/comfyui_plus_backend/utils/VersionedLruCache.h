@@ -0,0 +1,97 @@
+// app/include/comfyui_plus_backend/utils/VersionedLruCache.h
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Bounded LRU of immutable values derived from a specific workflow version
+ *
+ * Entries are keyed by workflow id and tagged with the version they were
+ * computed from. A lookup with a different version is a miss, so writes never
+ * need to invalidate explicitly; the stale entry is simply replaced.
+ */
+template <typename T>
+class VersionedLruCache
+{
+public:
+    explicit VersionedLruCache(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    // Returns the cached value for (id, version), or nullptr
+    std::shared_ptr<const T> get(int64_t id, int64_t version)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(id);
+        if (it == index_.end() || it->second->version != version) {
+            ++misses_;
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        ++hits_;
+        return it->second->value;
+    }
+
+    void put(int64_t id, int64_t version, std::shared_ptr<const T> value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(id);
+        if (it != index_.end()) {
+            // Never let a slower computation of an older version overwrite a newer one
+            if (it->second->version > version) {
+                return;
+            }
+            it->second->version = version;
+            it->second->value = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        entries_.push_front(Entry{id, version, std::move(value)});
+        index_.emplace(id, entries_.begin());
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().id);
+            entries_.pop_back();
+        }
+    }
+
+    void erase(int64_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(id);
+        if (it != index_.end()) {
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+    }
+
+    uint64_t hits() const { std::lock_guard<std::mutex> lock(mutex_); return hits_; }
+    uint64_t misses() const { std::lock_guard<std::mutex> lock(mutex_); return misses_; }
+
+private:
+    struct Entry {
+        int64_t id;
+        int64_t version;
+        std::shared_ptr<const T> value;
+    };
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_; // Most recently used first
+    std::unordered_map<int64_t, typename std::list<Entry>::iterator> index_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,56 @@
+// app/include/comfyui_plus_backend/utils/WorkerPool.h
+#pragma once
+
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Worker threads sized and placed by one PoolTopology
+ *
+ * A queued task runs as part of the request that queued it: its trace is
+ * current while it runs, and the time it waited is recorded as waitPhase in
+ * that trace and added to the pool's task and wait counters in Metrics.
+ */
+class WorkerPool
+{
+public:
+    // waitPhase must be a string literal, e.g. "wait.db_worker"
+    WorkerPool(const std::string &name,
+               const PoolTopology &pool,
+               Metrics::Counter waitCounter,
+               Metrics::Counter taskCounter,
+               const char *waitPhase);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Queues a task; it runs on whichever worker is free first
+    void runTask(std::function<void()> &&task);
+
+    // Runs task once on every worker, e.g. to set up thread-local state
+    void runOnEachWorker(std::function<void()> task);
+
+    size_t threadCount() const { return threadCount_; }
+
+private:
+    const size_t threadCount_;
+    const Metrics::Counter waitCounter_;
+    const Metrics::Counter taskCounter_;
+    const char *const waitPhase_;
+    trantor::ConcurrentTaskQueue queue_;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
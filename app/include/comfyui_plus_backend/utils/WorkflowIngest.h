@@ -0,0 +1,75 @@
+// app/include/comfyui_plus_backend/utils/WorkflowIngest.h
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+/**
+ * @brief Metadata extracted from a ComfyUI workflow graph without building a DOM
+ */
+struct WorkflowSummary {
+    size_t nodeCount = 0;
+    size_t linkCount = 0;
+    std::vector<std::string> nodeTypes; // Distinct node types, sorted
+};
+
+/**
+ * @brief A parsed create/update payload for a workflow
+ *
+ * `jsonData` is a view of the original `json_data` bytes. It points into a
+ * thread-local scratch buffer and is only valid until the next call to
+ * WorkflowIngest::parseUpload() on the same thread, so callers must copy it
+ * into storage before parsing anything else.
+ */
+struct WorkflowUpload {
+    std::optional<std::string> name;
+    std::optional<std::string> description;
+    std::optional<bool> isPublic;
+    std::optional<std::string_view> jsonData;
+    // Bytes readable from jsonData->data(), simdjson padding included, so the
+    // graph can be parsed again in place; see graph::splitLayout
+    size_t jsonDataCapacity = 0;
+    WorkflowSummary summary;
+};
+
+/**
+ * @brief simdjson On-Demand based ingest path for workflow payloads
+ *
+ * The request body is validated in a single forward pass and the `json_data`
+ * graph is kept as the raw bytes the client sent, so nothing is re-serialized
+ * before storage. Both the ComfyUI UI format (`nodes`/`links` arrays) and the
+ * API prompt format (`{"<id>": {"class_type": ...}}`) are recognised.
+ */
+class WorkflowIngest
+{
+  public:
+    // Parses a workflow create/update body of the form
+    // {"name": ..., "description": ..., "is_public": ..., "json_data": {...}}.
+    // When requireJsonData is true a missing json_data field is an error.
+    // Returns the parsed upload or a client-facing error message.
+    static std::expected<WorkflowUpload, std::string> parseUpload(std::string_view body,
+                                                                  bool requireJsonData);
+
+    // Validates a raw workflow graph and extracts its summary.
+    // Returns the summary or a client-facing error message.
+    static std::expected<WorkflowSummary, std::string> summarize(std::string_view jsonData);
+
+    // In code points, not bytes
+    static constexpr size_t MAX_NAME_LENGTH = 256;
+    static constexpr size_t MAX_DESCRIPTION_LENGTH = 4096;
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,35 @@
+// app/include/comfyui_plus_backend/utils/WorkflowJson.h
+#pragma once
+
+#include "comfyui_plus_backend/models/Workflow.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+class WorkflowJson
+{
+public:
+    // Writes the metadata members into the currently open object; json_data
+    // is never part of it
+    static void writeMetadata(JsonWriter &json, const models::Workflow &workflow);
+
+    // Renders {"workflow":{<metadata>,"<name>":<raw>,...}}, splicing each raw
+    // JSON member in verbatim. Used for both live responses and the
+    // precompressed variants, so the two are byte-identical.
+    static std::string documentBody(
+        const models::Workflow &workflow,
+        std::initializer_list<std::pair<std::string_view, std::string_view>> rawMembers);
+};
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,71 @@
+// app/loadgen/LatencyHistogram.cc
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+unsigned LatencyHistogram::indexFor(uint64_t micros)
+{
+    if (micros < kLinearBuckets) {
+        return static_cast<unsigned>(micros);
+    }
+    // Shift so the value's top six bits remain: 32..63
+    unsigned shift = static_cast<unsigned>(std::bit_width(micros)) - 6;
+    if (shift > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    return kLinearBuckets + (shift - 1) * kSubBuckets + static_cast<unsigned>((micros >> shift) - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::upperBound(unsigned index)
+{
+    if (index < kLinearBuckets) {
+        return index;
+    }
+    const unsigned offset = index - kLinearBuckets;
+    const unsigned shift = offset / kSubBuckets + 1;
+    const uint64_t top = offset % kSubBuckets + kSubBuckets;
+    return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros)
+{
+    ++buckets_[indexFor(micros)];
+    ++count_;
+    sum_ += micros;
+    max_ = std::max(max_, micros);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (unsigned i = 0; i < kBucketCount; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::percentile(double q) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    const auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            return std::min(upperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
@@ -0,0 +1,48 @@
+// app/loadgen/LatencyHistogram.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+/**
+ * @brief Log-linear latency histogram in microseconds
+ *
+ * Values below 64 us are exact; above that each power of two is split into
+ * 32 buckets, so a reported percentile is within 3% of the true value. One
+ * histogram belongs to one event loop; merge() combines them for the report.
+ */
+class LatencyHistogram
+{
+public:
+    void record(uint64_t micros);
+    void merge(const LatencyHistogram &other);
+
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Smallest recorded bucket value at or above quantile q (0 < q <= 1)
+    uint64_t percentile(double q) const;
+
+private:
+    static constexpr unsigned kLinearBuckets = 64;
+    static constexpr unsigned kSubBuckets = 32;
+    static constexpr unsigned kMaxExponent = 40; // ~12 days
+    static constexpr unsigned kBucketCount = kLinearBuckets + kMaxExponent * kSubBuckets;
+
+    static unsigned indexFor(uint64_t micros);
+    static uint64_t upperBound(unsigned index);
+
+    std::array<uint64_t, kBucketCount> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
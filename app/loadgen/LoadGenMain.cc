@@ -0,0 +1,241 @@
+// app/loadgen/LoadGenMain.cc
+// Drives scripted scenarios against a running ComfyUIPlusBackend at a fixed
+// arrival rate and reports throughput and latency percentiles per step.
+#include "Runner.h"
+#include "Scenario.h"
+#include <trantor/utils/Logger.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace cupb_loadgen = comfyui_plus_backend::loadgen;
+
+namespace
+{
+
+constexpr const char *kUsage = R"(Usage: ComfyUIPlusBackend_loadgen [--option=value ...]
+
+  --url=URL                 Server to load (default http://127.0.0.1:8080)
+  --rate=N                  Scenario arrivals per second (default 100)
+  --duration=SECONDS        Measured run time (default 30)
+  --warmup=SECONDS          Unmeasured lead-in (default 5)
+  --connections=N           Keep-alive connections (default 16)
+  --threads=N               Event loops driving them (default 2)
+  --users=N                 Users registered before the run (default 16)
+  --workflows-per-user=N    Workflows created per user before the run (default 4)
+  --workflow-nodes=N        Nodes in each uploaded workflow, ~1.5 KB each (default 50)
+  --timeout=SECONDS         Per request (default 30)
+  --scenarios=FILE          Scenario JSON to use instead of the built-in set
+  --mix=NAME:W,...          Scenario weights; unnamed scenarios are not run
+  --json=FILE               Also write the report as JSON
+  --list                    Print the built-in scenarios and exit
+)";
+
+template <typename T>
+bool parseNumber(std::string_view text, T &out, bool allowZero = false)
+{
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && ptr == text.data() + text.size() && (out > 0 || (allowZero && out == 0));
+}
+
+double millis(uint64_t micros)
+{
+    return static_cast<double>(micros) / 1000.0;
+}
+
+void printRow(const cupb_loadgen::LatencyReport &report, double seconds, bool indent)
+{
+    const auto &latency = report.latency;
+    std::printf("%-34s %9llu %7llu %9.1f %9.2f %9.2f %9.2f %9.2f\n",
+                ((indent ? "  " : "") + report.name).c_str(),
+                static_cast<unsigned long long>(latency.count()),
+                static_cast<unsigned long long>(report.errors),
+                static_cast<double>(latency.count()) / seconds,
+                millis(latency.percentile(0.5)), millis(latency.percentile(0.99)),
+                millis(latency.percentile(0.999)), millis(latency.max()));
+}
+
+Json::Value toJson(const cupb_loadgen::LatencyReport &report, double seconds)
+{
+    const auto &latency = report.latency;
+    Json::Value row;
+    row["name"] = report.name;
+    row["count"] = static_cast<Json::UInt64>(latency.count());
+    row["errors"] = static_cast<Json::UInt64>(report.errors);
+    row["throughput_per_sec"] = static_cast<double>(latency.count()) / seconds;
+    row["mean_ms"] = latency.mean() / 1000.0;
+    row["p50_ms"] = millis(latency.percentile(0.5));
+    row["p99_ms"] = millis(latency.percentile(0.99));
+    row["p999_ms"] = millis(latency.percentile(0.999));
+    row["max_ms"] = millis(latency.max());
+    return row;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    cupb_loadgen::RunOptions options;
+    std::string scenariosFile;
+    std::string mix;
+    std::string jsonFile;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            std::cout << kUsage;
+            return 0;
+        }
+        if (arg == "--list") {
+            std::cout << cupb_loadgen::kDefaultScenarios << std::endl;
+            return 0;
+        }
+
+        size_t eq = arg.find('=');
+        if (!arg.starts_with("--") || eq == std::string_view::npos) {
+            std::cerr << "Unrecognized argument " << arg << "\n\n" << kUsage;
+            return 1;
+        }
+        std::string_view name = arg.substr(2, eq - 2);
+        std::string_view value = arg.substr(eq + 1);
+
+        bool valid = true;
+        if (name == "url") {
+            options.url = value;
+        } else if (name == "rate") {
+            valid = parseNumber(value, options.rate);
+        } else if (name == "duration") {
+            valid = parseNumber(value, options.durationSeconds);
+        } else if (name == "warmup") {
+            valid = parseNumber(value, options.warmupSeconds, true);
+        } else if (name == "connections") {
+            valid = parseNumber(value, options.connections);
+        } else if (name == "threads") {
+            valid = parseNumber(value, options.threads);
+        } else if (name == "users") {
+            valid = parseNumber(value, options.users);
+        } else if (name == "workflows-per-user") {
+            valid = parseNumber(value, options.workflowsPerUser, true);
+        } else if (name == "workflow-nodes") {
+            valid = parseNumber(value, options.workflowNodes);
+        } else if (name == "timeout") {
+            valid = parseNumber(value, options.timeoutSeconds);
+        } else if (name == "scenarios") {
+            scenariosFile = value;
+        } else if (name == "mix") {
+            mix = value;
+        } else if (name == "json") {
+            jsonFile = value;
+        } else {
+            std::cerr << "Unknown option --" << name << "\n\n" << kUsage;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Invalid value for --" << name << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    // Every event loop needs at least one connection
+    options.threads = std::min(options.threads, options.connections);
+
+    std::string scenarioText = cupb_loadgen::kDefaultScenarios;
+    if (!scenariosFile.empty()) {
+        std::ifstream in(scenariosFile);
+        if (!in) {
+            std::cerr << "Cannot read " << scenariosFile << std::endl;
+            return 1;
+        }
+        scenarioText.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    std::string parseErrors;
+    std::istringstream scenarioStream(scenarioText);
+    if (!Json::parseFromStream(builder, scenarioStream, &root, &parseErrors)) {
+        std::cerr << "Error parsing scenarios: " << parseErrors << std::endl;
+        return 1;
+    }
+    auto scenarios = cupb_loadgen::loadScenarios(root);
+    if (!scenarios) {
+        std::cerr << "Invalid scenarios: " << scenarios.error() << std::endl;
+        return 1;
+    }
+    if (!mix.empty()) {
+        if (auto applied = cupb_loadgen::applyMix(*scenarios, mix); !applied) {
+            std::cerr << applied.error() << std::endl;
+            return 1;
+        }
+    }
+    double totalWeight = 0;
+    for (const auto &scenario : *scenarios) {
+        totalWeight += scenario.weight;
+    }
+    if (totalWeight <= 0) {
+        std::cerr << "Every scenario has weight 0; nothing to run" << std::endl;
+        return 1;
+    }
+
+    trantor::Logger::setLogLevel(trantor::Logger::kWarn);
+
+    cupb_loadgen::Runner runner(options, std::move(*scenarios));
+    if (auto setUp = runner.setUp(); !setUp) {
+        std::cerr << setUp.error() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Running " << options.rate << " arrivals/s for " << options.warmupSeconds << "s warmup + "
+              << options.durationSeconds << "s against " << options.url << std::endl;
+    auto report = runner.run();
+
+    std::printf("%-34s %9s %7s %9s %9s %9s %9s %9s\n", "scenario / step", "count", "errors", "per sec",
+                "p50 ms", "p99 ms", "p99.9 ms", "max ms");
+    for (const auto &scenario : report.scenarios) {
+        if (scenario.latency.count() == 0) {
+            continue;
+        }
+        printRow(scenario, report.measuredSeconds, false);
+        for (const auto &step : report.steps) {
+            if (step.name.starts_with(scenario.name + ".")) {
+                printRow(step, report.measuredSeconds, true);
+            }
+        }
+    }
+    if (report.lateArrivals > 0) {
+        std::printf("\n%llu arrivals were sent more than 1 ms late; the load generator is saturated, "
+                    "add --threads\n",
+                    static_cast<unsigned long long>(report.lateArrivals));
+    }
+
+    if (!jsonFile.empty()) {
+        Json::Value out;
+        out["url"] = options.url;
+        out["rate"] = options.rate;
+        out["duration_sec"] = report.measuredSeconds;
+        out["connections"] = static_cast<Json::UInt64>(options.connections);
+        out["workflow_nodes"] = static_cast<Json::UInt64>(options.workflowNodes);
+        out["late_arrivals"] = static_cast<Json::UInt64>(report.lateArrivals);
+        out["scenarios"] = Json::arrayValue;
+        for (const auto &scenario : report.scenarios) {
+            out["scenarios"].append(toJson(scenario, report.measuredSeconds));
+        }
+        out["steps"] = Json::arrayValue;
+        for (const auto &step : report.steps) {
+            out["steps"].append(toJson(step, report.measuredSeconds));
+        }
+        std::ofstream jsonOut(jsonFile);
+        jsonOut << out.toStyledString();
+        if (!jsonOut) {
+            std::cerr << "Failed to write " << jsonFile << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
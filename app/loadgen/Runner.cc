@@ -0,0 +1,376 @@
+// app/loadgen/Runner.cc
+#include "Runner.h"
+#include "BenchWorkflows.h"
+#include <trantor/net/EventLoop.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <tuple>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+struct Runner::Loop {
+    std::unique_ptr<trantor::EventLoopThread> thread;
+    std::vector<drogon::HttpClientPtr> clients;
+    size_t nextClient = 0;
+
+    // Everything below is touched only on this loop's thread
+    std::mt19937_64 random;
+    std::vector<LatencyReport> scenarios;
+    std::vector<LatencyReport> steps;
+    Clock::time_point nextArrival;
+    Clock::duration interval{};
+    uint64_t sequence = 0;
+    uint64_t lateArrivals = 0;
+    trantor::TimerId timer = 0;
+
+    std::atomic<uint64_t> outstanding{0};
+    std::atomic<bool> scheduling{false};
+};
+
+struct Runner::ScenarioRun {
+    size_t scenario = 0;
+    size_t step = 0;
+    Session session;
+    Clock::time_point arrival;
+    Clock::time_point stepStart;
+    bool measured = false;
+};
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t micros(Clock::duration elapsed)
+{
+    return static_cast<uint64_t>(
+        std::max<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(), 0));
+}
+
+std::string toJson(const Json::Value &value)
+{
+    Json::StreamWriterBuilder compact;
+    compact["indentation"] = "";
+    return Json::writeString(compact, value);
+}
+
+drogon::HttpRequestPtr makeJsonRequest(drogon::HttpMethod method, const std::string &path, const Json::Value &body)
+{
+    auto req = drogon::HttpRequest::newHttpRequest();
+    req->setMethod(method);
+    req->setPath(path);
+    req->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    req->setBody(toJson(body));
+    return req;
+}
+
+// Base 36 seconds since the epoch: short enough for usernames, distinct per run
+std::string makeRunId()
+{
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string id;
+    do {
+        id.insert(id.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[seconds % 36]);
+        seconds /= 36;
+    } while (seconds > 0);
+    return id;
+}
+
+std::string_view describe(drogon::ReqResult result)
+{
+    switch (result) {
+    case drogon::ReqResult::Ok:
+        return "ok";
+    case drogon::ReqResult::BadResponse:
+        return "bad response";
+    case drogon::ReqResult::NetworkFailure:
+        return "network failure";
+    case drogon::ReqResult::BadServerAddress:
+        return "bad server address";
+    case drogon::ReqResult::Timeout:
+        return "timeout";
+    default:
+        return "TLS failure";
+    }
+}
+
+std::string describeFailure(const std::string &what, drogon::ReqResult result, const drogon::HttpResponsePtr &resp)
+{
+    if (result != drogon::ReqResult::Ok || !resp) {
+        return what + " failed: " + std::string(describe(result));
+    }
+    return what + " returned " + std::to_string(static_cast<int>(resp->statusCode())) + ": " +
+           std::string(resp->body());
+}
+
+} // namespace
+
+Runner::Runner(RunOptions options, std::vector<Scenario> scenarios)
+    : options_(std::move(options)),
+      scenarios_(std::move(scenarios)),
+      runId_(makeRunId()),
+      password_("loadgen-" + runId_ + "-password"),
+      workflowBody_(bench::makeUploadBody(bench::makeSyntheticWorkflow(options_.workflowNodes)))
+{
+    double total = 0;
+    size_t steps = 0;
+    for (const auto &scenario : scenarios_) {
+        total += scenario.weight;
+        cumulativeWeights_.push_back(total);
+        stepOffsets_.push_back(steps);
+        steps += scenario.steps.size();
+    }
+
+    std::random_device seed;
+    for (size_t i = 0; i < options_.threads; ++i) {
+        auto loop = std::make_unique<Loop>();
+        loop->thread = std::make_unique<trantor::EventLoopThread>("LoadGen" + std::to_string(i));
+        loop->thread->run();
+        loop->random.seed(seed());
+        for (const auto &scenario : scenarios_) {
+            loop->scenarios.push_back({scenario.name, {}, 0});
+            for (const auto &step : scenario.steps) {
+                loop->steps.push_back({scenario.name + "." + step.name, {}, 0});
+            }
+        }
+        loops_.push_back(std::move(loop));
+    }
+    for (size_t i = 0; i < options_.connections; ++i) {
+        auto &loop = *loops_[i % loops_.size()];
+        loop.clients.push_back(drogon::HttpClient::newHttpClient(options_.url, loop.thread->getLoop()));
+    }
+}
+
+Runner::~Runner()
+{
+    // Clients are released on their own loop before the loop stops
+    for (auto &loop : loops_) {
+        std::promise<void> released;
+        loop->thread->getLoop()->runInLoop([&loop, &released]() {
+            loop->clients.clear();
+            released.set_value();
+        });
+        released.get_future().wait();
+    }
+}
+
+std::expected<void, std::string> Runner::setUp()
+{
+    // Synchronous requests may not be sent from the client's own loop; this
+    // runs on the main thread
+    auto &client = loops_.front()->clients.front();
+    const double timeout = options_.timeoutSeconds;
+
+    users_.resize(options_.users);
+    for (size_t i = 0; i < users_.size(); ++i) {
+        auto &user = users_[i];
+        user.username = "lg" + runId_ + "_u" + std::to_string(i);
+        user.email = user.username + "@loadgen.test";
+
+        Json::Value registration;
+        registration["username"] = user.username;
+        registration["email"] = user.email;
+        registration["password"] = password_;
+        auto [result, resp] = client->sendRequest(makeJsonRequest(drogon::Post, "/auth/register", registration),
+                                                  timeout);
+        if (result != drogon::ReqResult::Ok || !resp || resp->statusCode() != drogon::k201Created) {
+            return std::unexpected(describeFailure("Registering " + user.username, result, resp));
+        }
+
+        Json::Value login;
+        login["username"] = user.username;
+        login["password"] = password_;
+        std::tie(result, resp) = client->sendRequest(makeJsonRequest(drogon::Post, "/auth/login", login), timeout);
+        if (result != drogon::ReqResult::Ok || !resp || resp->statusCode() != drogon::k200OK ||
+            !resp->getJsonObject() || !(*resp->getJsonObject())["token"].isString()) {
+            return std::unexpected(describeFailure("Logging in " + user.username, result, resp));
+        }
+        user.token = (*resp->getJsonObject())["token"].asString();
+
+        for (size_t w = 0; w < options_.workflowsPerUser; ++w) {
+            auto req = drogon::HttpRequest::newHttpRequest();
+            req->setMethod(drogon::Post);
+            req->setPath("/workflows");
+            req->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+            req->addHeader("Authorization", "Bearer " + user.token);
+            req->setBody(workflowBody_);
+            std::tie(result, resp) = client->sendRequest(req, timeout);
+            if (result != drogon::ReqResult::Ok || !resp || resp->statusCode() != drogon::k201Created ||
+                !resp->getJsonObject() || !(*resp->getJsonObject())["workflow"]["id"].isIntegral()) {
+                return std::unexpected(describeFailure("Creating a workflow for " + user.username, result, resp));
+            }
+            user.workflowIds.push_back((*resp->getJsonObject())["workflow"]["id"].asInt64());
+        }
+        std::cerr << "\rSet up " << (i + 1) << "/" << users_.size() << " users" << std::flush;
+    }
+    std::cerr << std::endl;
+    return {};
+}
+
+void Runner::startScenario(Loop &loop, Clock::time_point arrival)
+{
+    auto run = std::make_shared<ScenarioRun>();
+    std::uniform_real_distribution<double> pick(0.0, cumulativeWeights_.back());
+    run->scenario = static_cast<size_t>(
+        std::upper_bound(cumulativeWeights_.begin(), cumulativeWeights_.end(), pick(loop.random)) -
+        cumulativeWeights_.begin());
+    // A draw of exactly the total falls past the end; take the last weighted one
+    while (run->scenario == scenarios_.size() || scenarios_[run->scenario].weight == 0) {
+        --run->scenario;
+    }
+
+    const auto &user = users_[std::uniform_int_distribution<size_t>(0, users_.size() - 1)(loop.random)];
+    run->session.username = &user.username;
+    run->session.email = &user.email;
+    run->session.password = &password_;
+    run->session.token = &user.token;
+    run->session.workflowBody = &workflowBody_;
+    if (!user.workflowIds.empty()) {
+        run->session.workflowId =
+            user.workflowIds[std::uniform_int_distribution<size_t>(0, user.workflowIds.size() - 1)(loop.random)];
+    }
+    run->session.sequence = loop.sequence;
+    loop.sequence += loops_.size();
+    run->session.runId = runId_;
+
+    run->arrival = arrival;
+    run->stepStart = arrival;
+    run->measured = arrival >= measureFrom_;
+
+    loop.outstanding.fetch_add(1, std::memory_order_relaxed);
+    sendStep(loop, run);
+}
+
+void Runner::sendStep(Loop &loop, const std::shared_ptr<ScenarioRun> &run)
+{
+    const Step &step = scenarios_[run->scenario].steps[run->step];
+    auto req = drogon::HttpRequest::newHttpRequest();
+    req->setMethod(step.method);
+    req->setPath(step.path.expand(run->session));
+    if (step.body) {
+        req->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+        req->setBody(step.body->expand(run->session));
+    }
+    if (step.auth) {
+        req->addHeader("Authorization", "Bearer " + *run->session.token);
+    }
+
+    auto &client = loop.clients[loop.nextClient++ % loop.clients.size()];
+    client->sendRequest(
+        req,
+        [this, &loop, run](drogon::ReqResult result, const drogon::HttpResponsePtr &resp) {
+            const auto now = Clock::now();
+            const bool ok = result == drogon::ReqResult::Ok && resp &&
+                            static_cast<int>(resp->statusCode()) >= 200 &&
+                            static_cast<int>(resp->statusCode()) < 300;
+            const auto &steps = scenarios_[run->scenario].steps;
+            if (run->measured) {
+                auto &report = loop.steps[stepOffsets_[run->scenario] + run->step];
+                report.latency.record(micros(now - run->stepStart));
+                report.errors += ok ? 0 : 1;
+            }
+
+            if (ok && run->step + 1 < steps.size()) {
+                ++run->step;
+                run->stepStart = now;
+                sendStep(loop, run);
+                return;
+            }
+
+            if (run->measured) {
+                auto &report = loop.scenarios[run->scenario];
+                report.latency.record(micros(now - run->arrival));
+                report.errors += ok ? 0 : 1;
+            }
+            loop.outstanding.fetch_sub(1, std::memory_order_relaxed);
+        },
+        options_.timeoutSeconds);
+}
+
+RunReport Runner::run()
+{
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+    measureFrom_ = start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(options_.warmupSeconds));
+    stopAt_ = measureFrom_ + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(options_.durationSeconds));
+
+    // Loop i takes arrivals i, i + n, i + 2n, ... of the overall schedule
+    const auto spacing = std::chrono::duration<double>(1.0 / options_.rate);
+    for (size_t i = 0; i < loops_.size(); ++i) {
+        auto &loop = *loops_[i];
+        loop.nextArrival = start + std::chrono::duration_cast<Clock::duration>(spacing * static_cast<double>(i));
+        loop.interval =
+            std::chrono::duration_cast<Clock::duration>(spacing * static_cast<double>(loops_.size()));
+        loop.sequence = i;
+        loop.scheduling.store(true);
+
+        auto *eventLoop = loop.thread->getLoop();
+        eventLoop->runInLoop([this, &loop, eventLoop]() {
+            loop.timer = eventLoop->runEvery(0.001, [this, &loop, eventLoop]() {
+                const auto now = Clock::now();
+                while (loop.nextArrival <= now && loop.nextArrival < stopAt_) {
+                    if (loop.nextArrival >= measureFrom_ && now - loop.nextArrival > std::chrono::milliseconds(1)) {
+                        ++loop.lateArrivals;
+                    }
+                    startScenario(loop, loop.nextArrival);
+                    loop.nextArrival += loop.interval;
+                }
+                if (loop.nextArrival >= stopAt_) {
+                    eventLoop->invalidateTimer(loop.timer);
+                    loop.scheduling.store(false);
+                }
+            });
+        });
+    }
+
+    std::this_thread::sleep_until(stopAt_);
+
+    // Requests still out after their timeout were failed by the client
+    const auto drainUntil = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                               std::chrono::duration<double>(options_.timeoutSeconds + 1));
+    auto busy = [this]() {
+        return std::any_of(loops_.begin(), loops_.end(), [](const auto &loop) {
+            return loop->scheduling.load() || loop->outstanding.load(std::memory_order_relaxed) > 0;
+        });
+    };
+    while (busy() && Clock::now() < drainUntil) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    RunReport report;
+    report.measuredSeconds = options_.durationSeconds;
+    for (auto &loop : loops_) {
+        std::promise<void> collected;
+        loop->thread->getLoop()->runInLoop([&loop, &report, &collected]() {
+            if (report.scenarios.empty()) {
+                report.scenarios = loop->scenarios;
+                report.steps = loop->steps;
+            } else {
+                for (size_t i = 0; i < report.scenarios.size(); ++i) {
+                    report.scenarios[i].latency.merge(loop->scenarios[i].latency);
+                    report.scenarios[i].errors += loop->scenarios[i].errors;
+                }
+                for (size_t i = 0; i < report.steps.size(); ++i) {
+                    report.steps[i].latency.merge(loop->steps[i].latency);
+                    report.steps[i].errors += loop->steps[i].errors;
+                }
+            }
+            report.lateArrivals += loop->lateArrivals;
+            collected.set_value();
+        });
+        collected.get_future().wait();
+    }
+    return report;
+}
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
@@ -0,0 +1,99 @@
+// app/loadgen/Runner.h
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "Scenario.h"
+#include <drogon/HttpClient.h>
+#include <trantor/net/EventLoopThread.h>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+struct RunOptions {
+    std::string url = "http://127.0.0.1:8080";
+    double rate = 100;            // Scenario arrivals per second
+    double durationSeconds = 30;  // Measured
+    double warmupSeconds = 5;     // Run but not measured
+    size_t connections = 16;      // Keep-alive connections, spread over the threads
+    size_t threads = 2;           // Event loops driving the connections
+    size_t users = 16;            // Registered before the run; scenarios pick one at random
+    size_t workflowsPerUser = 4;  // Created per user before the run, for reads and updates
+    size_t workflowNodes = 50;    // Nodes per ${workflow_body}, about 1.5 KB each
+    double timeoutSeconds = 30;   // Per request
+};
+
+struct LatencyReport {
+    std::string name;
+    LatencyHistogram latency;
+    uint64_t errors = 0; // Transport failures and non-2xx responses
+};
+
+struct RunReport {
+    double measuredSeconds = 0;
+    uint64_t lateArrivals = 0;          // Sent more than 1 ms after their scheduled time
+    std::vector<LatencyReport> scenarios; // Arrival to last response
+    std::vector<LatencyReport> steps;     // "scenario.step"
+};
+
+/**
+ * @brief Drives scenarios against a running server at a fixed arrival rate
+ *
+ * Open loop: arrivals are scheduled at 1/rate intervals whatever the server
+ * does, and a scenario's first request is timed from its scheduled arrival,
+ * not from when it was sent. Time spent queued behind a busy connection or a
+ * late timer therefore counts, which is the coordinated-omission correction;
+ * a closed-loop client would instead slow down with the server and hide it.
+ * Later steps of a scenario are timed from the previous step's response.
+ */
+class Runner
+{
+public:
+    Runner(RunOptions options, std::vector<Scenario> scenarios);
+    ~Runner();
+
+    // Registers and logs in the users and creates their workflows
+    std::expected<void, std::string> setUp();
+
+    RunReport run();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct SeededUser {
+        std::string username;
+        std::string email;
+        std::string token;
+        std::vector<int64_t> workflowIds;
+    };
+
+    struct Loop;
+    struct ScenarioRun;
+
+    void startScenario(Loop &loop, Clock::time_point arrival);
+    void sendStep(Loop &loop, const std::shared_ptr<ScenarioRun> &run);
+
+    RunOptions options_;
+    std::vector<Scenario> scenarios_;
+    std::vector<double> cumulativeWeights_;
+    std::vector<size_t> stepOffsets_; // Index of each scenario's first step in Loop::steps
+
+    std::string runId_;
+    std::string password_;
+    std::string workflowBody_;
+    std::vector<SeededUser> users_;
+
+    Clock::time_point measureFrom_;
+    Clock::time_point stopAt_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+};
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
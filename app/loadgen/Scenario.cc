@@ -0,0 +1,248 @@
+// app/loadgen/Scenario.cc
+#include "Scenario.h"
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <utility>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+const char *const kDefaultScenarios = R"json({
+    "scenarios": [
+        {
+            "name": "browse",
+            "weight": 6,
+            "steps": [
+                {"name": "list", "method": "GET", "path": "/workflows", "auth": true},
+                {"name": "get", "method": "GET", "path": "/workflows/${workflow_id}", "auth": true}
+            ]
+        },
+        {
+            "name": "create",
+            "weight": 2,
+            "steps": [
+                {"name": "create", "method": "POST", "path": "/workflows", "auth": true, "body": "${workflow_body}"}
+            ]
+        },
+        {
+            "name": "update",
+            "weight": 1,
+            "steps": [
+                {"name": "get", "method": "GET", "path": "/workflows/${workflow_id}", "auth": true},
+                {"name": "update", "method": "PUT", "path": "/workflows/${workflow_id}", "auth": true,
+                 "body": "${workflow_body}"}
+            ]
+        },
+        {
+            "name": "login",
+            "weight": 1,
+            "steps": [
+                {"name": "login", "method": "POST", "path": "/auth/login",
+                 "body": {"username": "${username}", "password": "${password}"}}
+            ]
+        },
+        {
+            "name": "register",
+            "weight": 0,
+            "steps": [
+                {"name": "register", "method": "POST", "path": "/auth/register",
+                 "body": {"username": "lg${run}_${seq}", "email": "lg${run}_${seq}@loadgen.test",
+                          "password": "${password}"}}
+            ]
+        }
+    ]
+})json";
+
+namespace
+{
+
+std::optional<drogon::HttpMethod> parseMethod(std::string_view method)
+{
+    if (method == "GET") {
+        return drogon::Get;
+    }
+    if (method == "POST") {
+        return drogon::Post;
+    }
+    if (method == "PUT") {
+        return drogon::Put;
+    }
+    if (method == "DELETE") {
+        return drogon::Delete;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+std::expected<Template, std::string> Template::compile(std::string_view text)
+{
+    static constexpr std::pair<std::string_view, Variable> kVariables[] = {
+        {"username", Variable::Username},         {"email", Variable::Email},
+        {"password", Variable::Password},         {"workflow_id", Variable::WorkflowId},
+        {"workflow_body", Variable::WorkflowBody}, {"seq", Variable::Sequence},
+        {"run", Variable::RunId}};
+
+    Template result;
+    Segment segment;
+    while (!text.empty()) {
+        size_t open = text.find("${");
+        if (open == std::string_view::npos) {
+            segment.literal.append(text);
+            break;
+        }
+        size_t close = text.find('}', open);
+        if (close == std::string_view::npos) {
+            return std::unexpected("Unterminated placeholder in \"" + std::string(text) + "\"");
+        }
+        segment.literal.append(text.substr(0, open));
+        std::string_view name = text.substr(open + 2, close - open - 2);
+
+        auto known = std::find_if(std::begin(kVariables), std::end(kVariables),
+                                  [name](const auto &variable) { return variable.first == name; });
+        if (known == std::end(kVariables)) {
+            return std::unexpected("Unknown placeholder ${" + std::string(name) + "}");
+        }
+        segment.variable = known->second;
+        result.segments_.push_back(std::move(segment));
+        segment = Segment();
+        text.remove_prefix(close + 1);
+    }
+    if (!segment.literal.empty() || result.segments_.empty()) {
+        result.segments_.push_back(std::move(segment));
+    }
+    return result;
+}
+
+std::string Template::expand(const Session &session) const
+{
+    std::string out;
+    for (const auto &segment : segments_) {
+        out.append(segment.literal);
+        if (!segment.variable) {
+            continue;
+        }
+        switch (*segment.variable) {
+        case Variable::Username:
+            out.append(*session.username);
+            break;
+        case Variable::Email:
+            out.append(*session.email);
+            break;
+        case Variable::Password:
+            out.append(*session.password);
+            break;
+        case Variable::WorkflowId:
+            out.append(std::to_string(session.workflowId));
+            break;
+        case Variable::WorkflowBody:
+            out.append(*session.workflowBody);
+            break;
+        case Variable::Sequence:
+            out.append(std::to_string(session.sequence));
+            break;
+        case Variable::RunId:
+            out.append(session.runId);
+            break;
+        }
+    }
+    return out;
+}
+
+std::expected<std::vector<Scenario>, std::string> loadScenarios(const Json::Value &root)
+{
+    if (!root.isObject() || !root["scenarios"].isArray() || root["scenarios"].empty()) {
+        return std::unexpected("Expected {\"scenarios\": [...]} with at least one scenario");
+    }
+
+    Json::StreamWriterBuilder compact;
+    compact["indentation"] = "";
+
+    std::vector<Scenario> scenarios;
+    for (const auto &entry : root["scenarios"]) {
+        Scenario scenario;
+        scenario.name = entry.get("name", "").asString();
+        if (scenario.name.empty()) {
+            return std::unexpected("Every scenario needs a name");
+        }
+        if (!entry.get("weight", 1.0).isNumeric() || entry.get("weight", 1.0).asDouble() < 0) {
+            return std::unexpected(scenario.name + ": weight must be a number >= 0");
+        }
+        scenario.weight = entry.get("weight", 1.0).asDouble();
+        if (!entry["steps"].isArray() || entry["steps"].empty()) {
+            return std::unexpected(scenario.name + ": steps must be a non-empty array");
+        }
+
+        for (const auto &stepJson : entry["steps"]) {
+            Step step;
+            step.name = stepJson.get("name", "").asString();
+            const std::string where = scenario.name + "." + step.name;
+            auto method = parseMethod(stepJson.get("method", "GET").asString());
+            if (step.name.empty() || !method) {
+                return std::unexpected(where + ": each step needs a name and GET, POST, PUT or DELETE");
+            }
+            step.method = *method;
+            step.auth = stepJson.get("auth", false).asBool();
+
+            const std::string pathText = stepJson.get("path", "").asString();
+            if (!pathText.starts_with('/')) {
+                return std::unexpected(where + ": path must start with /");
+            }
+            auto path = Template::compile(pathText);
+            if (!path) {
+                return std::unexpected(where + ": " + path.error());
+            }
+            step.path = std::move(*path);
+
+            const Json::Value &body = stepJson["body"];
+            if (!body.isNull()) {
+                auto compiled = Template::compile(body.isString() ? body.asString()
+                                                                  : Json::writeString(compact, body));
+                if (!compiled) {
+                    return std::unexpected(where + ": " + compiled.error());
+                }
+                step.body = std::move(*compiled);
+            }
+            scenario.steps.push_back(std::move(step));
+        }
+        scenarios.push_back(std::move(scenario));
+    }
+    return scenarios;
+}
+
+std::expected<void, std::string> applyMix(std::vector<Scenario> &scenarios, std::string_view mix)
+{
+    for (auto &scenario : scenarios) {
+        scenario.weight = 0;
+    }
+    while (!mix.empty()) {
+        size_t end = mix.find(',');
+        std::string_view entry = mix.substr(0, end);
+        mix.remove_prefix(end == std::string_view::npos ? mix.size() : end + 1);
+
+        size_t colon = entry.find(':');
+        std::string_view name = entry.substr(0, colon);
+        double weight = 1.0;
+        if (colon != std::string_view::npos) {
+            std::string_view value = entry.substr(colon + 1);
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), weight);
+            if (ec != std::errc() || ptr != value.data() + value.size() || weight < 0) {
+                return std::unexpected("Invalid weight in --mix entry \"" + std::string(entry) + "\"");
+            }
+        }
+
+        auto scenario = std::find_if(scenarios.begin(), scenarios.end(),
+                                     [name](const Scenario &s) { return s.name == name; });
+        if (scenario == scenarios.end()) {
+            return std::unexpected("--mix names an unknown scenario \"" + std::string(name) + "\"");
+        }
+        scenario->weight = weight;
+    }
+    return {};
+}
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
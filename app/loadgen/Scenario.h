@@ -0,0 +1,91 @@
+// app/loadgen/Scenario.h
+#pragma once
+
+#include <drogon/HttpTypes.h>
+#include <json/json.h>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace loadgen
+{
+
+// What one scenario run's ${...} placeholders expand to
+struct Session {
+    const std::string *username = nullptr;
+    const std::string *email = nullptr;
+    const std::string *password = nullptr;
+    const std::string *token = nullptr;
+    const std::string *workflowBody = nullptr;
+    int64_t workflowId = 0;
+    uint64_t sequence = 0;   // Unique per run of any scenario
+    std::string_view runId;  // Unique per load generator run
+};
+
+/**
+ * @brief A path or body with ${...} placeholders, split once at load
+ *
+ * Placeholders: ${username}, ${email}, ${password} and ${workflow_id} of a
+ * seeded user, ${workflow_body} (a POST /workflows body of --workflow-nodes
+ * nodes), ${seq} and ${run}, which together make a name no other request uses.
+ */
+class Template
+{
+public:
+    static std::expected<Template, std::string> compile(std::string_view text);
+
+    std::string expand(const Session &session) const;
+
+private:
+    enum class Variable {
+        Username,
+        Email,
+        Password,
+        WorkflowId,
+        WorkflowBody,
+        Sequence,
+        RunId
+    };
+
+    struct Segment {
+        std::string literal;
+        std::optional<Variable> variable; // Appended after the literal
+    };
+
+    std::vector<Segment> segments_;
+};
+
+struct Step {
+    std::string name;
+    drogon::HttpMethod method = drogon::Get;
+    Template path;
+    std::optional<Template> body; // Sent as application/json
+    bool auth = false;            // Sends the seeded user's bearer token
+};
+
+struct Scenario {
+    std::string name;
+    double weight = 1.0; // Share of arrivals; 0 leaves it out
+    std::vector<Step> steps;
+};
+
+/**
+ * Parses {"scenarios": [{"name", "weight", "steps": [{"name", "method",
+ * "path", "body", "auth"}]}]}. A string body is sent as is after expansion;
+ * an object body is serialized first. See kDefaultScenarios for an example.
+ */
+std::expected<std::vector<Scenario>, std::string> loadScenarios(const Json::Value &root);
+
+// Overrides weights from "name:weight,name:weight"; scenarios not named get 0
+std::expected<void, std::string> applyMix(std::vector<Scenario> &scenarios, std::string_view mix);
+
+// The routes of AuthController and WorkflowController, weighted towards reads
+extern const char *const kDefaultScenarios;
+
+} // namespace loadgen
+} // namespace comfyui_plus_backend
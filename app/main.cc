@@ -1,17 +1,42 @@
 // app/main.cc
 #include <drogon/drogon.h>
 #include <drogon/orm/DbClient.h>
+#include "comfyui_plus_backend/controllers/BatchController.h"
+#include "comfyui_plus_backend/controllers/WorkflowController.h"
 #include "comfyui_plus_backend/db/DatabaseManager.h"
 #include "comfyui_plus_backend/filters/JwtAuthFilter.h"
+#include "comfyui_plus_backend/filters/RateLimitFilter.h"
+#include "comfyui_plus_backend/services/UserService.h"
+#include "comfyui_plus_backend/utils/AsyncLogWriter.h"
+#include "comfyui_plus_backend/utils/LoadShedder.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include <algorithm>
 #include <fstream>  // For std::ofstream
 #include <sqlite3.h>  // Works with both SQLite and libSQL
 #include <memory>
 #include <filesystem>  // For std::filesystem
 #include <iostream>
+#include <string_view>
+#include <unordered_map>
 
 // Global variable to store our JWT config
 Json::Value globalJwtConfig;
 
+// Global variable to store the ComfyUI integration config
+Json::Value globalComfyUIConfig;
+
+// Global variable to store the workflow storage policy
+Json::Value globalWorkflowsConfig;
+
+// Global variable to store the user cache settings
+Json::Value globalUsersConfig;
+
+// Global variable to store the request tracing settings
+Json::Value globalTracingConfig;
+
 int main() {
     // Get the absolute path to the working directory
     std::filesystem::path currentPath = std::filesystem::current_path();
@@ -51,6 +76,18 @@ int main() {
                 } else {
                     std::cout << "JWT section NOT found in manually parsed config!" << std::endl;
                 }
+                if (config.isMember("comfyui")) {
+                    globalComfyUIConfig = config["comfyui"];
+                }
+                if (config.isMember("workflows")) {
+                    globalWorkflowsConfig = config["workflows"];
+                }
+                if (config.isMember("users")) {
+                    globalUsersConfig = config["users"];
+                }
+                if (config.isMember("tracing")) {
+                    globalTracingConfig = config["tracing"];
+                }
             } else {
                 std::cerr << "Error parsing JSON config: " << parseErrors << std::endl;
             }
@@ -91,9 +128,10 @@ int main() {
         
         // Add app section
         Json::Value app;
-        app["number_of_threads"] = 1;
         app["log_path"] = "./";
-        app["log_level"] = "DEBUG";
+        app["log_level"] = "INFO";
+        app["client_max_body_size"] = 64 * 1024 * 1024;
+        app["client_max_memory_body_size"] = 1024 * 1024;
         config["app"] = app;
         
         // Add JWT section
@@ -106,6 +144,85 @@ int main() {
         
         // Store the JWT config for later use
         globalJwtConfig = jwt;
+
+        // Add ComfyUI section; object_info.json is a saved GET /object_info response
+        Json::Value comfyui;
+        comfyui["object_info_path"] = "object_info.json";
+        config["comfyui"] = comfyui;
+        globalComfyUIConfig = comfyui;
+
+        // Add workflows section; uploads above max_upload_bytes and batches
+        // above max_batch_bytes get a 413
+        using comfyui_plus_backend::app::controllers::BatchController;
+        using comfyui_plus_backend::app::controllers::WorkflowController;
+        Json::Value workflows;
+        workflows["max_upload_bytes"] = static_cast<Json::UInt64>(WorkflowController::DEFAULT_MAX_UPLOAD_BYTES);
+        workflows["max_batch_bytes"] = static_cast<Json::UInt64>(BatchController::DEFAULT_MAX_BATCH_BYTES);
+        config["workflows"] = workflows;
+        globalWorkflowsConfig = workflows;
+
+        // Add users section; cache_capacity bounds the in-process user cache
+        Json::Value users;
+        users["cache_capacity"] = 10000;
+        config["users"] = users;
+        globalUsersConfig = users;
+
+        // Add tracing section; requests slower than slow_request_ms log their phases
+        Json::Value tracing;
+        tracing["enabled"] = true;
+        tracing["slow_request_ms"] = 1000;
+        tracing["otel_file"] = "";
+        config["tracing"] = tracing;
+        globalTracingConfig = tracing;
+
+        // Add threads section; 0 sizes a pool for this machine's core count
+        Json::Value threads;
+        threads["io_threads"] = 0;
+        threads["db_workers"] = 0;
+        threads["password_hash_workers"] = 0;
+        threads["batch_workers"] = 0;
+        threads["import_workers"] = 0;
+        threads["encode_workers"] = 0;
+        threads["pin_threads"] = false;
+        config["threads"] = threads;
+
+        // Add logging section; records are written by a background thread
+        Json::Value logging;
+        logging["async"] = true;
+        logging["format"] = "text";
+        logging["queue_records"] = 16384;
+        config["logging"] = logging;
+
+        // Add rate_limits section; login and registration beyond these get a 429
+        Json::Value rateLimits;
+        rateLimits["enabled"] = true;
+        rateLimits["per_ip"]["requests_per_minute"] = 30;
+        rateLimits["per_ip"]["burst"] = 10;
+        rateLimits["per_account"]["requests_per_minute"] = 10;
+        rateLimits["per_account"]["burst"] = 5;
+        rateLimits["max_keys"] = 100000;
+        rateLimits["use_forwarded_for"] = false;
+        rateLimits["exempt_ips"] = Json::Value(Json::arrayValue);
+        config["rate_limits"] = rateLimits;
+
+        // Add load_shedding section; each class's concurrency limit adapts to
+        // keep its latency near target_latency_ms, and the excess gets a 503
+        Json::Value loadShedding;
+        loadShedding["enabled"] = true;
+        loadShedding["backoff"] = 0.9;
+        loadShedding["auth"]["target_latency_ms"] = 250;
+        loadShedding["auth"]["initial_limit"] = 16;
+        loadShedding["auth"]["min_limit"] = 2;
+        loadShedding["auth"]["max_limit"] = 256;
+        loadShedding["workflow_read"]["target_latency_ms"] = 100;
+        loadShedding["workflow_read"]["initial_limit"] = 64;
+        loadShedding["workflow_read"]["min_limit"] = 4;
+        loadShedding["workflow_read"]["max_limit"] = 1024;
+        loadShedding["workflow_write"]["target_latency_ms"] = 250;
+        loadShedding["workflow_write"]["initial_limit"] = 32;
+        loadShedding["workflow_write"]["min_limit"] = 4;
+        loadShedding["workflow_write"]["max_limit"] = 512;
+        config["load_shedding"] = loadShedding;
         
         // Write the config to a file
         std::ofstream configOutFile(configPath);
@@ -118,9 +235,167 @@ int main() {
         }
     }
     
+    // Validated before anything starts a thread; pools read the active topology
+    using comfyui_plus_backend::app::utils::ThreadTopology;
+    auto topology = ThreadTopology::fromConfig(config["threads"]);
+    if (!topology) {
+        std::cerr << "Invalid config: " << topology.error() << std::endl;
+        return 1;
+    }
+    ThreadTopology::setActive(*topology);
+
+    using comfyui_plus_backend::app::filters::RateLimitFilter;
+    auto rateLimits = RateLimitFilter::settingsFromConfig(config["rate_limits"]);
+    if (!rateLimits) {
+        std::cerr << "Invalid config: " << rateLimits.error() << std::endl;
+        return 1;
+    }
+
+    using comfyui_plus_backend::app::utils::LoadShedder;
+    auto loadShedding = LoadShedder::settingsFromConfig(config["load_shedding"]);
+    if (!loadShedding) {
+        std::cerr << "Invalid config: " << loadShedding.error() << std::endl;
+        return 1;
+    }
+    LoadShedder::getInstance().configure(*loadShedding);
+
+    // app.log_level is honoured at run time; levels below the compile-time
+    // floor (COMFYUI_PLUS_MIN_LOG_LEVEL) were removed from this build
+    static const std::unordered_map<std::string, trantor::Logger::LogLevel> logLevels = {
+        {"TRACE", trantor::Logger::kTrace}, {"DEBUG", trantor::Logger::kDebug},
+        {"INFO", trantor::Logger::kInfo},   {"WARN", trantor::Logger::kWarn},
+        {"ERROR", trantor::Logger::kError}, {"FATAL", trantor::Logger::kFatal}};
+    auto logLevel = trantor::Logger::kInfo;
+    const std::string logLevelName = config["app"].get("log_level", "INFO").asString();
+    if (auto it = logLevels.find(logLevelName); it != logLevels.end()) {
+        logLevel = it->second;
+    } else {
+        std::cerr << "Unknown app.log_level " << logLevelName << ", using INFO" << std::endl;
+    }
+
+    const Json::Value &logging = config["logging"];
+    if (logging.get("async", true).asBool()) {
+        using comfyui_plus_backend::app::utils::AsyncLogWriter;
+        const std::string format = logging.get("format", "text").asString();
+        if (format != "text" && format != "json") {
+            std::cerr << "Invalid config: logging.format must be \"text\" or \"json\"" << std::endl;
+            return 1;
+        }
+        AsyncLogWriter::start(logging.get("queue_records", 16384).asUInt(),
+                              format == "json" ? AsyncLogWriter::Format::Json : AsyncLogWriter::Format::Text);
+    }
+
     // Initialize Drogon app with our config
-    drogon::app().setLogLevel(trantor::Logger::kDebug);
-    drogon::app().addListener("0.0.0.0", 8080);
+    drogon::app().setLogLevel(logLevel);
+
+    // Each `listeners` entry takes Drogon's keys: address, port, https, cert, key
+    const Json::Value &listeners = config["listeners"];
+    if (!listeners.isNull() && !listeners.isArray()) {
+        std::cerr << "Invalid config: listeners must be an array" << std::endl;
+        return 1;
+    }
+    for (const auto &listener : listeners) {
+        const Json::Value &port = listener["port"];
+        if (!listener.isObject() || !port.isUInt() || port.asUInt() == 0 || port.asUInt() > 65535) {
+            std::cerr << "Invalid config: every listeners entry needs a port from 1 to 65535" << std::endl;
+            return 1;
+        }
+        const bool https = listener.get("https", false).asBool();
+        if (https && (listener.get("cert", "").asString().empty() || listener.get("key", "").asString().empty())) {
+            std::cerr << "Invalid config: an https listener needs cert and key" << std::endl;
+            return 1;
+        }
+        drogon::app().addListener(listener.get("address", "0.0.0.0").asString(),
+                                  static_cast<uint16_t>(port.asUInt()),
+                                  https,
+                                  listener.get("cert", "").asString(),
+                                  listener.get("key", "").asString());
+    }
+    if (listeners.empty()) {
+        drogon::app().addListener("0.0.0.0", 8080);
+    }
+    drogon::app().setThreadNum(topology->io.threads);
+
+    // The I/O loops exist once the app runs; each pins itself on its own thread
+    if (!topology->io.cpus.empty()) {
+        drogon::app().registerBeginningAdvice([] {
+            const auto &active = ThreadTopology::active();
+            for (size_t i = 0; i < active.io.threads; ++i) {
+                drogon::app().getIOLoop(i)->queueInLoop([i] {
+                    const auto &active = ThreadTopology::active();
+                    ThreadTopology::applyAffinity(active.io.cpus, i, active.pinThreads);
+                });
+            }
+        });
+    }
+
+    // Workflow graphs can be tens of megabytes, far above Drogon's 1 MB default
+    size_t clientMaxBodySize = 64 * 1024 * 1024;
+    if (config["app"].isMember("client_max_body_size") && config["app"]["client_max_body_size"].isUInt64()) {
+        clientMaxBodySize = config["app"]["client_max_body_size"].asUInt64();
+    }
+    drogon::app().setClientMaxBodySize(clientMaxBodySize);
+
+    // Bodies above this are spooled to a temporary file and read through a
+    // memory map, so a large upload does not sit on the heap while it arrives
+    size_t clientMaxMemoryBodySize = 1024 * 1024;
+    if (config["app"].isMember("client_max_memory_body_size") &&
+        config["app"]["client_max_memory_body_size"].isUInt64()) {
+        clientMaxMemoryBodySize = config["app"]["client_max_memory_body_size"].asUInt64();
+    }
+    drogon::app().setClientMaxMemoryBodySize(clientMaxMemoryBodySize);
+
+    // Workflow reads send only the variants compressed in the background;
+    // Drogon's on-the-fly gzip would compress every other response on the
+    // I/O thread, under the identity ETag
+    drogon::app().enableGzip(false);
+    
+    // Each request is counted where it arrives and where its response leaves;
+    // GET /metrics sums the per-thread counts. Its trace starts and ends at
+    // the same two points and follows it across threads in between.
+    using comfyui_plus_backend::app::utils::Metrics;
+    using comfyui_plus_backend::app::utils::RequestTrace;
+    const bool tracing = RequestTrace::enabled();
+    drogon::app().registerPreRoutingAdvice([tracing](const drogon::HttpRequestPtr &req) {
+        Metrics::increment(Metrics::Counter::RequestsStarted);
+        if (tracing) {
+            auto trace = std::make_shared<RequestTrace>();
+            req->attributes()->insert("trace", trace);
+            RequestTrace::setCurrent(std::move(trace));
+            // Routing, filters and the handler run synchronously from here;
+            // the loop runs queued functors only once they return, so this
+            // clears the trace before other work on the loop is charged to it.
+            // Work deferred onto the loop for this request takes a Scope.
+            trantor::EventLoop::getEventLoopOfCurrentThread()->queueInLoop(
+                [] { RequestTrace::setCurrent(nullptr); });
+        }
+    });
+    // Runs after the advice above, so shed requests are still counted
+    drogon::app().registerPreRoutingAdvice(
+        [](const drogon::HttpRequestPtr &req, drogon::AdviceCallback &&reject, drogon::AdviceChainCallback &&next) {
+            if (LoadShedder::getInstance().admit(req)) {
+                next();
+            } else {
+                reject(LoadShedder::overloadedResponse());
+            }
+        });
+    drogon::app().registerPostHandlingAdvice(
+        [tracing](const drogon::HttpRequestPtr &req, const drogon::HttpResponsePtr &resp) {
+            LoadShedder::finish(req);
+            std::string_view route = req->getMatchedPathPattern();
+            if (route.empty()) {
+                route = "unmatched";
+            }
+            const int64_t latency = trantor::Date::now().microSecondsSinceEpoch() -
+                                    req->creationDate().microSecondsSinceEpoch();
+            const int status = static_cast<int>(resp->statusCode());
+            Metrics::recordRequest(req->methodString(), route, status,
+                                   static_cast<uint64_t>(std::max<int64_t>(latency, 0)));
+            if (tracing && req->attributes()->find("trace")) {
+                const auto &trace = req->attributes()->get<std::shared_ptr<RequestTrace>>("trace");
+                trace->finish(req->methodString(), route, status);
+            }
+        });
     
     // Initialize database client manually if needed
     // We'll use the DatabaseManager's initialization instead
@@ -134,18 +409,43 @@ int main() {
     // Initialize database
     auto& dbManager = comfyui_plus_backend::app::db::DatabaseManager::getInstance();
     dbManager.initialize("comfyui_plus.sqlite");
+
+    // Every thread that queries opens its connection before the first request
+    // needs it; /health/ready reports 503 until they all have
+    drogon::app().registerBeginningAdvice([] {
+        comfyui_plus_backend::app::db::DatabaseManager::getInstance().warmUpAllConnections();
+    });
+
+    // Lets registrations skip existence queries for names nobody has taken
+    comfyui_plus_backend::app::services::UserService().loadExistenceFilter();
     
     // Create a JWT filter instance
     auto jwtFilter = std::make_shared<comfyui_plus_backend::app::filters::JwtAuthFilter>();
     
     // Register the filter
     drogon::app().registerFilter(jwtFilter);
+
+    // Named by the auth routes, so it is registered even when disabled
+    drogon::app().registerFilter(std::make_shared<RateLimitFilter>(*rateLimits));
     
     // Log startup information
+    LOG_INFO << "Thread topology: " << topology->io.threads << " I/O, "
+             << topology->dbWorkers.threads << " DB, "
+             << topology->passwordHashWorkers.threads << " password hash threads on "
+             << ThreadTopology::hardwareThreads() << " hardware threads"
+             << (topology->pinThreads ? " (pinned)" : "");
+    if (static_cast<int>(logLevel) < COMFYUI_PLUS_MIN_LOG_LEVEL) {
+        LOG_WARN << "app.log_level " << logLevelName << " is below this build's floor; "
+                 << "rebuild with -DCOMFYUI_PLUS_MIN_LOG_LEVEL=" << static_cast<int>(logLevel)
+                 << " to see those records";
+    }
     LOG_INFO << "Server starting...";
     
     // Run the HTTP server
     drogon::app().run();
+
+    // Whatever is still queued is written before exit
+    comfyui_plus_backend::app::utils::AsyncLogWriter::stop();
     
     return 0;
 }
\ No newline at end of file
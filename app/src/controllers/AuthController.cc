@@ -1,12 +1,41 @@
 #include "comfyui_plus_backend/controllers/AuthController.h"
-#include <json/json.h>     // For Json::Value, Drogon uses jsoncpp
+#include "comfyui_plus_backend/filters/RateLimitFilter.h"
+#include "comfyui_plus_backend/models/AuthRequests.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/PasswordHashPool.h"
+#include "comfyui_plus_backend/utils/ReflectJson.h"
 #include <drogon/utils/FunctionTraits.h> // For traits if needed, often for callback types
 #include <drogon/HttpTypes.h> // For k400BadRequest etc.
 #include <drogon/drogon.h>    // For LOG_DEBUG etc.
 
 namespace cupb_controllers = comfyui_plus_backend::app::controllers;
 namespace cupb_services = comfyui_plus_backend::app::services;
+namespace cupb_models = comfyui_plus_backend::app::models;
+namespace cupb_utils = comfyui_plus_backend::app::utils;
 
+namespace
+{
+
+drogon::HttpResponsePtr makeErrorResponse(const std::string &message, drogon::HttpStatusCode statusCode)
+{
+    cupb_utils::JsonWriter json(message.size() + 16);
+    json.beginObject().field("error", message).endObject();
+    return std::move(json).toResponse(statusCode);
+}
+
+// RateLimitFilter has usually parsed the body already to find the account
+template <typename Request>
+std::expected<Request, cupb_utils::reflect::ReadError> readBody(const drogon::HttpRequestPtr &req)
+{
+    const auto &attributes = req->attributes();
+    if (attributes->find(comfyui_plus_backend::app::filters::RateLimitFilter::kParsedBodyAttribute)) {
+        return attributes->get<Request>(comfyui_plus_backend::app::filters::RateLimitFilter::kParsedBodyAttribute);
+    }
+    return cupb_utils::reflect::fromJson<Request>(req->body());
+}
+
+} // namespace
 
 cupb_controllers::AuthController::AuthController()
     : authService_(std::make_shared<cupb_services::AuthService>())
@@ -20,69 +49,38 @@ void cupb_controllers::AuthController::handleRegister(
     std::function<void(const drogon::HttpResponsePtr &)> &&callback)
 {
     LOG_DEBUG << "Handling /auth/register request";
-    auto jsonBodyPtr = req->getJsonObject(); // Returns std::shared_ptr<Json::Value>
-
-    if (!jsonBodyPtr)
+    // Validated against the RegisterRequest schema while it is parsed; no
+    // Json::Value DOM is built, and oversized bodies are never parsed
+    auto body = readBody<cupb_models::RegisterRequest>(req);
+    if (!body)
     {
-        Json::Value errorJson;
-        errorJson["error"] = "Invalid JSON payload.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
+        callback(makeErrorResponse(body.error().message(), drogon::HttpStatusCode::k400BadRequest));
         return;
     }
-    const auto& jsonBody = *jsonBodyPtr; // Dereference for easier access
-
-    // Validate presence of required fields
-    if (!jsonBody.isMember("username") || !jsonBody["username"].isString() ||
-        !jsonBody.isMember("email") || !jsonBody["email"].isString() ||
-        !jsonBody.isMember("password") || !jsonBody["password"].isString())
-    {
-        Json::Value errorJson;
-        errorJson["error"] = "Missing or invalid fields: username, email, and password are required strings.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
-        return;
-    }
-
-    std::string username = jsonBody["username"].asString();
-    std::string email = jsonBody["email"].asString();
-    std::string password = jsonBody["password"].asString();
 
-    // Call the AuthService using the legacy return type for now
-    auto [userOpt, errorMsg] = authService_->registerUserLegacy(username, email, password);
-
-    if (userOpt)
-    {
-        Json::Value successJson;
-        successJson["message"] = "User registered successfully.";
-        // Construct a safe user object for the response (no sensitive data)
-        Json::Value userJson;
-        userJson["id"] = static_cast<Json::Int64>(userOpt->getId().value_or(0));
-        userJson["username"] = userOpt->getUsername();
-        userJson["email"] = userOpt->getEmail();
-        successJson["user"] = userJson;
-
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(successJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k201Created);
-        callback(resp);
-    }
-    else
-    {
-        Json::Value errorJson;
-        errorJson["error"] = errorMsg;
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        // Try to determine status code from message
-        if (errorMsg.find("exists") != std::string::npos) {
-            resp->setStatusCode(drogon::HttpStatusCode::k409Conflict);
-        } else if (errorMsg.find("character") != std::string::npos || errorMsg.find("empty") != std::string::npos) {
-            resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        } else {
-            resp->setStatusCode(drogon::HttpStatusCode::k500InternalServerError);
-        }
-        callback(resp);
-    }
+    // Argon2 would stall this I/O loop; a hash worker registers and answers
+    cupb_utils::PasswordHashPool::getInstance().runTask(
+        [authService = authService_, body = std::move(*body), callback = std::move(callback)]()
+        {
+            auto user = authService->registerUser(body.username, body.email, body.password);
+
+            if (user)
+            {
+                // The password hash is a sensitive field and is never serialized
+                cupb_utils::JsonWriter json;
+                json.beginObject().field("message", "User registered successfully.").key("user");
+                cupb_utils::reflect::writeValue(json, *user);
+                json.endObject();
+
+                callback(std::move(json).toResponse(drogon::HttpStatusCode::k201Created));
+            }
+            else
+            {
+                // AuthService picks the status: 400 invalid input, 409 taken, 500 otherwise
+                callback(makeErrorResponse(user.error().message,
+                                           static_cast<drogon::HttpStatusCode>(user.error().statusCode)));
+            }
+        });
 }
 
 // Login Handler
@@ -91,64 +89,46 @@ void cupb_controllers::AuthController::handleLogin(
     std::function<void(const drogon::HttpResponsePtr &)> &&callback)
 {
     LOG_DEBUG << "Handling /auth/login request";
-    auto jsonBodyPtr = req->getJsonObject();
-
-    if (!jsonBodyPtr)
+    auto body = readBody<cupb_models::LoginRequest>(req);
+    if (!body)
     {
-        Json::Value errorJson;
-        errorJson["error"] = "Invalid JSON payload.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
+        callback(makeErrorResponse(body.error().message(), drogon::HttpStatusCode::k400BadRequest));
         return;
     }
-    const auto& jsonBody = *jsonBodyPtr;
 
-    if ((!jsonBody.isMember("emailOrUsername") || !jsonBody["emailOrUsername"].isString()) &&
-        (!jsonBody.isMember("username") || !jsonBody["username"].isString()) &&
-        (!jsonBody.isMember("email") || !jsonBody["email"].isString()) ||
-        !jsonBody.isMember("password") || !jsonBody["password"].isString())
+    const auto &loginIdentifier = body->emailOrUsername ? body->emailOrUsername
+                                  : body->email         ? body->email
+                                                        : body->username;
+    if (!loginIdentifier)
     {
-        Json::Value errorJson;
-        errorJson["error"] = "Missing or invalid fields: (emailOrUsername or email or username) and password are required.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
+        callback(makeErrorResponse(
+            "Missing or invalid fields: (emailOrUsername or email or username) and password are required.",
+            drogon::HttpStatusCode::k400BadRequest));
         return;
     }
 
-    std::string loginIdentifier;
-    if (jsonBody.isMember("emailOrUsername") && jsonBody["emailOrUsername"].isString()) {
-        loginIdentifier = jsonBody["emailOrUsername"].asString();
-    } else if (jsonBody.isMember("email") && jsonBody["email"].isString()) {
-        loginIdentifier = jsonBody["email"].asString();
-    } else if (jsonBody.isMember("username") && jsonBody["username"].isString()) {
-        loginIdentifier = jsonBody["username"].asString();
-    }
-
-    std::string password = jsonBody["password"].asString();
-
-    // Call the AuthService with the legacy return type
-    auto [tokenOpt, errorMsg] = authService_->loginUserLegacy(loginIdentifier, password);
-
-    if (tokenOpt)
-    {
-        Json::Value successJson;
-        successJson["message"] = "Login successful.";
-        successJson["token"] = *tokenOpt;
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(successJson);
-        callback(resp);
-    }
-    else
-    {
-        Json::Value errorJson;
-        errorJson["error"] = errorMsg;
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        if (errorMsg.find("Invalid credentials") != std::string::npos) {
-            resp->setStatusCode(drogon::HttpStatusCode::k401Unauthorized);
-        } else {
-            resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        }
-        callback(resp);
-    }
+    // Verification hashes too, so it runs on the hash pool as well
+    cupb_utils::PasswordHashPool::getInstance().runTask(
+        [authService = authService_,
+         identifier = *loginIdentifier,
+         password = std::move(body->password),
+         callback = std::move(callback)]()
+        {
+            // Call the AuthService with the legacy return type
+            auto [tokenOpt, errorMsg] = authService->loginUserLegacy(identifier, password);
+
+            if (tokenOpt)
+            {
+                cupb_utils::JsonWriter json(tokenOpt->size() + 48);
+                json.beginObject().field("message", "Login successful.").field("token", *tokenOpt).endObject();
+                callback(std::move(json).toResponse());
+            }
+            else
+            {
+                auto status = errorMsg.find("Invalid credentials") != std::string::npos
+                                  ? drogon::HttpStatusCode::k401Unauthorized
+                                  : drogon::HttpStatusCode::k400BadRequest;
+                callback(makeErrorResponse(errorMsg, status));
+            }
+        });
 }
\ No newline at end of file
@@ -0,0 +1,349 @@
+// app/src/controllers/BatchController.cc
+#include "comfyui_plus_backend/controllers/BatchController.h"
+#include "comfyui_plus_backend/controllers/WorkflowController.h"
+#include "comfyui_plus_backend/db/DbWorkerPool.h"
+#include "comfyui_plus_backend/utils/BatchRequest.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include <drogon/drogon.h>
+#include <future>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+extern Json::Value globalWorkflowsConfig;
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+namespace
+{
+
+namespace cupb_utils = comfyui_plus_backend::app::utils;
+
+using Handler = std::function<void(const drogon::HttpRequestPtr &,
+                                   std::function<void(const drogon::HttpResponsePtr &)> &&)>;
+
+drogon::HttpResponsePtr makeErrorResponse(const std::string &message, int statusCode)
+{
+    cupb_utils::JsonWriter json(message.size() + 16);
+    json.beginObject().field("error", message).endObject();
+    return std::move(json).toResponse(static_cast<drogon::HttpStatusCode>(statusCode));
+}
+
+// How a sub-request is scheduled relative to its neighbours
+enum class ItemKind {
+    Read,    // Runs in parallel with adjacent reads
+    Create,  // Inserted together with adjacent creates
+    Write,   // Runs alone
+    Rejected // Never dispatched; the response is already set
+};
+
+struct Dispatch {
+    ItemKind kind = ItemKind::Rejected;
+    Handler handler;
+    drogon::HttpRequestPtr request;
+};
+
+std::optional<drogon::HttpMethod> parseMethod(std::string_view method)
+{
+    if (method == "GET") {
+        return drogon::Get;
+    }
+    if (method == "POST") {
+        return drogon::Post;
+    }
+    if (method == "PUT") {
+        return drogon::Put;
+    }
+    if (method == "DELETE") {
+        return drogon::Delete;
+    }
+    return std::nullopt;
+}
+
+// Builds the request a handler sees. The caller's identity is copied from the
+// batch, which JwtAuthFilter has already verified.
+drogon::HttpRequestPtr makeSubRequest(const drogon::HttpRequestPtr &batch,
+                                      const cupb_utils::BatchItem &item,
+                                      drogon::HttpMethod method,
+                                      std::string_view path,
+                                      std::string_view query)
+{
+    auto sub = drogon::HttpRequest::newHttpRequest();
+    sub->setMethod(method);
+    sub->setPath(std::string(path));
+
+    while (!query.empty()) {
+        size_t end = query.find('&');
+        std::string_view pair = query.substr(0, end);
+        query.remove_prefix(end == std::string_view::npos ? query.size() : end + 1);
+        size_t eq = pair.find('=');
+        std::string key(pair.substr(0, eq));
+        std::string value(eq == std::string_view::npos ? std::string_view() : pair.substr(eq + 1));
+        if (!key.empty()) {
+            sub->setParameter(drogon::utils::urlDecode(key), drogon::utils::urlDecode(value));
+        }
+    }
+
+    if (!item.body.empty()) {
+        sub->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+        sub->setBody(item.body);
+    }
+
+    sub->attributes()->insert("user_id", batch->attributes()->get<int64_t>("user_id"));
+    if (batch->attributes()->find("username")) {
+        sub->attributes()->insert("username", batch->attributes()->get<std::string>("username"));
+    }
+    return sub;
+}
+
+// Maps a sub-request onto a WorkflowController route. Listing, export and
+// import stream or run for a long time, so they are not offered in a batch.
+Dispatch resolve(const std::shared_ptr<WorkflowController> &workflows,
+                 const drogon::HttpRequestPtr &batch,
+                 const cupb_utils::BatchItem &item,
+                 drogon::HttpResponsePtr &rejection)
+{
+    Dispatch dispatch;
+    auto method = parseMethod(item.method);
+    if (!method) {
+        rejection = makeErrorResponse("Unsupported method: " + item.method, 405);
+        return dispatch;
+    }
+
+    std::string_view target = item.path;
+    size_t queryStart = target.find('?');
+    std::string_view path = target.substr(0, queryStart);
+    std::string_view query =
+        queryStart == std::string_view::npos ? std::string_view() : target.substr(queryStart + 1);
+    dispatch.request = makeSubRequest(batch, item, *method, path, query);
+
+    constexpr std::string_view prefix = "/workflows";
+    if (path == prefix) {
+        if (*method == drogon::Post) {
+            dispatch.kind = ItemKind::Create;
+        } else {
+            rejection = makeErrorResponse("Not available in a batch: " + item.method + " " + std::string(path), 400);
+        }
+        return dispatch;
+    }
+    if (!path.starts_with(prefix) || path.size() <= prefix.size() + 1 || path[prefix.size()] != '/') {
+        rejection = makeErrorResponse("Not found: " + std::string(path), 404);
+        return dispatch;
+    }
+
+    std::string_view rest = path.substr(prefix.size() + 1);
+    size_t slash = rest.find('/');
+    std::string id(rest.substr(0, slash));
+    std::string_view action = slash == std::string_view::npos ? std::string_view() : rest.substr(slash);
+
+    if (id == "export" || id == "import") {
+        rejection = makeErrorResponse("Not available in a batch: " + item.method + " " + std::string(path), 400);
+        return dispatch;
+    }
+
+    if (action.empty()) {
+        switch (*method) {
+        case drogon::Get:
+            dispatch.kind = ItemKind::Read;
+            dispatch.handler = [workflows, id](const auto &req, auto &&callback) {
+                workflows->getWorkflowById(req, std::move(callback), id);
+            };
+            return dispatch;
+        case drogon::Put:
+            dispatch.kind = ItemKind::Write;
+            dispatch.handler = [workflows, id](const auto &req, auto &&callback) {
+                workflows->updateWorkflow(req, std::move(callback), id);
+            };
+            return dispatch;
+        case drogon::Delete:
+            dispatch.kind = ItemKind::Write;
+            dispatch.handler = [workflows, id](const auto &req, auto &&callback) {
+                workflows->deleteWorkflow(req, std::move(callback), id);
+            };
+            return dispatch;
+        default:
+            break;
+        }
+    } else if ((action == "/analysis" || action == "/prompt") && *method == drogon::Get) {
+        dispatch.kind = ItemKind::Read;
+        if (action == "/analysis") {
+            dispatch.handler = [workflows, id](const auto &req, auto &&callback) {
+                workflows->getWorkflowAnalysis(req, std::move(callback), id);
+            };
+        } else {
+            dispatch.handler = [workflows, id](const auto &req, auto &&callback) {
+                workflows->getWorkflowPrompt(req, std::move(callback), id);
+            };
+        }
+        return dispatch;
+    } else if (action != "/analysis" && action != "/prompt") {
+        rejection = makeErrorResponse("Not found: " + std::string(path), 404);
+        return dispatch;
+    }
+
+    rejection = makeErrorResponse("Method not allowed: " + item.method + " " + std::string(path), 405);
+    return dispatch;
+}
+
+// Runs a handler and waits for its response. Every workflow handler except
+// import answers before returning, so this only blocks across the call.
+drogon::HttpResponsePtr invoke(const Dispatch &dispatch)
+{
+    std::promise<drogon::HttpResponsePtr> done;
+    auto response = done.get_future();
+    try {
+        dispatch.handler(dispatch.request,
+                         [&done](const drogon::HttpResponsePtr &resp) { done.set_value(resp); });
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Batch item " << dispatch.request->getPath() << " threw: " << e.what();
+        return makeErrorResponse("Internal server error.", 500);
+    }
+    return response.get();
+}
+
+} // namespace
+
+BatchController::BatchController()
+{
+    const auto &topology = cupb_utils::ThreadTopology::active();
+    cupb_utils::ThreadTopology::applyAffinity(batchQueue_, topology.batchWorkers, topology.pinThreads);
+
+    const auto &jsonConfig = drogon::app().getCustomConfig();
+    const Json::Value &workflowsConfig = jsonConfig.isNull() || !jsonConfig.isMember("workflows")
+        ? globalWorkflowsConfig
+        : jsonConfig["workflows"];
+    if (workflowsConfig.isMember("max_batch_bytes") && workflowsConfig["max_batch_bytes"].isUInt64()) {
+        maxBatchBytes_ = workflowsConfig["max_batch_bytes"].asUInt64();
+    }
+
+    LOG_DEBUG << "BatchController constructed";
+}
+
+void BatchController::handleBatch(
+    const drogon::HttpRequestPtr &req,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    LOG_DEBUG << "Handling POST /batch request";
+
+    if (req->body().size() > maxBatchBytes_) {
+        callback(makeErrorResponse("Batch body exceeds the " + std::to_string(maxBatchBytes_) +
+                                   " byte batch limit.", 413));
+        return;
+    }
+
+    auto items = cupb_utils::BatchRequest::parse(req->body(), MAX_ITEMS);
+    if (!items) {
+        callback(makeErrorResponse(items.error(), 400));
+        return;
+    }
+
+    // The batch blocks while its reads run, so it is coordinated off the I/O thread
+    batchQueue_.runTaskInQueue([req, items = std::move(*items), callback = std::move(callback),
+                                trace = cupb_utils::RequestTrace::current()]() {
+        cupb_utils::RequestTrace::Scope traceScope(trace);
+        auto workflows = drogon::DrClassMap::getSingleInstance<WorkflowController>();
+        auto userId = req->attributes()->get<int64_t>("user_id");
+
+        std::vector<drogon::HttpResponsePtr> responses(items.size());
+        std::vector<Dispatch> dispatches;
+        dispatches.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            dispatches.push_back(resolve(workflows, req, items[i], responses[i]));
+        }
+
+        // Items run in order, a run of same-kind neighbours at a time, so a
+        // read that follows a write in the batch sees that write
+        size_t next = 0;
+        while (next < items.size()) {
+            const ItemKind kind = dispatches[next].kind;
+            if (kind == ItemKind::Rejected) {
+                ++next;
+                continue;
+            }
+
+            size_t end = next + 1;
+            if (kind != ItemKind::Write) {
+                while (end < items.size() &&
+                       (dispatches[end].kind == kind || dispatches[end].kind == ItemKind::Rejected)) {
+                    ++end;
+                }
+            }
+
+            if (kind == ItemKind::Read) {
+                std::vector<size_t> reads;
+                for (size_t i = next; i < end; ++i) {
+                    if (dispatches[i].kind == ItemKind::Read) {
+                        reads.push_back(i);
+                    }
+                }
+                if (reads.size() == 1) {
+                    responses[reads.front()] = invoke(dispatches[reads.front()]);
+                } else {
+                    // Each worker reads through its own SQLite connection
+                    std::latch pending(static_cast<std::ptrdiff_t>(reads.size()));
+                    for (size_t i : reads) {
+                        db::DbWorkerPool::getInstance().runTask([&dispatches, &responses, &pending, i]() {
+                            responses[i] = invoke(dispatches[i]);
+                            pending.count_down();
+                        });
+                    }
+                    pending.wait();
+                }
+            } else if (kind == ItemKind::Create) {
+                std::vector<size_t> creates;
+                std::vector<std::string_view> bodies;
+                for (size_t i = next; i < end; ++i) {
+                    if (dispatches[i].kind == ItemKind::Create) {
+                        creates.push_back(i);
+                        bodies.push_back(items[i].body);
+                    }
+                }
+                auto created = workflows->createWorkflows(userId, bodies);
+                for (size_t c = 0; c < creates.size(); ++c) {
+                    responses[creates[c]] = std::move(created[c]);
+                }
+            } else {
+                responses[next] = invoke(dispatches[next]);
+            }
+            next = end;
+        }
+
+        size_t bodyBytes = 0;
+        for (const auto &resp : responses) {
+            bodyBytes += resp->body().size();
+        }
+
+        cupb_utils::JsonWriter json(bodyBytes + responses.size() * 32 + 32);
+        json.beginObject().key("responses").beginArray();
+        for (const auto &resp : responses) {
+            json.beginObject().field("status", static_cast<int>(resp->statusCode())).key("body");
+            std::string_view body = resp->body();
+            if (body.empty()) {
+                json.null();
+            } else if (resp->contentType() == drogon::CT_APPLICATION_JSON) {
+                json.raw(body);
+            } else {
+                json.value(body);
+            }
+            json.endObject();
+        }
+        json.endArray().endObject();
+
+        LOG_DEBUG << "Batch of " << items.size() << " requests done for user " << userId;
+        callback(std::move(json).toResponse());
+    });
+}
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
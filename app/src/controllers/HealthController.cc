@@ -0,0 +1,48 @@
+// app/src/controllers/HealthController.cc
+#include "comfyui_plus_backend/controllers/HealthController.h"
+#include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include <string_view>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+namespace
+{
+
+drogon::HttpResponsePtr makeStatusResponse(std::string_view status, drogon::HttpStatusCode statusCode)
+{
+    utils::JsonWriter json(32);
+    json.beginObject().field("status", status).endObject();
+    auto resp = std::move(json).toResponse(statusCode);
+    resp->addHeader("Cache-Control", "no-store");
+    return resp;
+}
+
+} // namespace
+
+void HealthController::live(
+    const drogon::HttpRequestPtr &,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    callback(makeStatusResponse("ok", drogon::k200OK));
+}
+
+void HealthController::ready(
+    const drogon::HttpRequestPtr &,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    if (db::DatabaseManager::getInstance().isWarm()) {
+        callback(makeStatusResponse("ready", drogon::k200OK));
+    } else {
+        callback(makeStatusResponse("warming", drogon::k503ServiceUnavailable));
+    }
+}
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
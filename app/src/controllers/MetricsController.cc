@@ -0,0 +1,69 @@
+// app/src/controllers/MetricsController.cc
+#include "comfyui_plus_backend/controllers/MetricsController.h"
+#include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/services/UserCache.h"
+#include "comfyui_plus_backend/utils/LoadShedder.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include <string>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace controllers
+{
+
+void MetricsController::scrape(
+    const drogon::HttpRequestPtr &,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    std::string body = utils::Metrics::render();
+
+    const auto &userCache = services::UserCache::getInstance();
+    body.append("# HELP comfyui_plus_user_cache_lookups_total User cache lookups, by result.\n"
+                "# TYPE comfyui_plus_user_cache_lookups_total counter\n"
+                "comfyui_plus_user_cache_lookups_total{result=\"hit\"} ")
+        .append(std::to_string(userCache.hits()))
+        .append("\ncomfyui_plus_user_cache_lookups_total{result=\"miss\"} ")
+        .append(std::to_string(userCache.misses()))
+        .append("\n# HELP comfyui_plus_user_cache_entries Users held by the user cache.\n"
+                "# TYPE comfyui_plus_user_cache_entries gauge\n"
+                "comfyui_plus_user_cache_entries ")
+        .append(std::to_string(userCache.size()))
+        .append("\n# HELP comfyui_plus_db_connections_warm 1 once every thread's database connection is warm.\n"
+                "# TYPE comfyui_plus_db_connections_warm gauge\n"
+                "comfyui_plus_db_connections_warm ")
+        .append(db::DatabaseManager::getInstance().isWarm() ? "1" : "0")
+        .append("\n");
+
+    // The limits move with observed latency; see utils::LoadShedder
+    using utils::LoadShedder;
+    const auto &shedder = LoadShedder::getInstance();
+    if (shedder.enabled()) {
+        std::string limits("# HELP comfyui_plus_concurrency_limit Requests each route class may have in flight.\n"
+                           "# TYPE comfyui_plus_concurrency_limit gauge\n");
+        std::string inFlight("# HELP comfyui_plus_concurrency_in_flight Admitted requests not yet answered.\n"
+                             "# TYPE comfyui_plus_concurrency_in_flight gauge\n");
+        std::string shed("# HELP comfyui_plus_load_shed_total Requests refused with 503 at the concurrency limit.\n"
+                         "# TYPE comfyui_plus_load_shed_total counter\n");
+        for (size_t i = 0; i < LoadShedder::kClassCount; ++i) {
+            const auto routeClass = static_cast<LoadShedder::RouteClass>(i);
+            const auto &limiter = shedder.limiter(routeClass);
+            const std::string labels = std::string("{class=\"").append(LoadShedder::className(routeClass)).append("\"} ");
+            limits.append("comfyui_plus_concurrency_limit").append(labels).append(std::to_string(limiter.limit())).append("\n");
+            inFlight.append("comfyui_plus_concurrency_in_flight").append(labels).append(std::to_string(limiter.inFlight())).append("\n");
+            shed.append("comfyui_plus_load_shed_total").append(labels).append(std::to_string(limiter.rejected())).append("\n");
+        }
+        body.append(limits).append(inFlight).append(shed);
+    }
+
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setContentTypeString("text/plain; version=0.0.4; charset=utf-8");
+    resp->addHeader("Cache-Control", "no-store");
+    resp->setBody(std::move(body));
+    callback(resp);
+}
+
+} // namespace controllers
+} // namespace app
+} // namespace comfyui_plus_backend
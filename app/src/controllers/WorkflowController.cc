@@ -1,6 +1,25 @@
 #include "comfyui_plus_backend/controllers/WorkflowController.h"
-#include <json/json.h>
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/WorkflowIngest.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include "comfyui_plus_backend/utils/LoadShedder.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include "comfyui_plus_backend/utils/WorkflowJson.h"
+#include "comfyui_plus_backend/graph/WorkflowLayout.h"
+#include "comfyui_plus_backend/db/DbWorkerPool.h"
+#include <drogon/drogon.h>
 #include <drogon/HttpTypes.h>
+#include <trantor/net/EventLoop.h>
+#include <trantor/net/TcpConnection.h>
+#include <algorithm>
+#include <charconv>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+extern Json::Value globalWorkflowsConfig;
 
 namespace comfyui_plus_backend
 {
@@ -9,8 +28,344 @@ namespace app
 namespace controllers
 {
 
+namespace
+{
+
+namespace cupb_models = comfyui_plus_backend::app::models;
+namespace cupb_db_models = comfyui_plus_backend::app::db::models;
+namespace cupb_utils = comfyui_plus_backend::app::utils;
+
+drogon::HttpResponsePtr makeErrorResponse(const std::string &message, int statusCode)
+{
+    cupb_utils::JsonWriter json(message.size() + 16);
+    json.beginObject().field("error", message).endObject();
+    return std::move(json).toResponse(static_cast<drogon::HttpStatusCode>(statusCode));
+}
+
+std::string uploadTooLargeMessage(size_t maxUploadBytes)
+{
+    return "Workflow body exceeds the " + std::to_string(maxUploadBytes) + " byte upload limit.";
+}
+
+std::optional<int64_t> parseWorkflowId(const std::string &id)
+{
+    int64_t value = 0;
+    auto [ptr, ec] = std::from_chars(id.data(), id.data() + id.size(), value);
+    if (ec != std::errc() || ptr != id.data() + id.size() || value <= 0) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Strong validator for one representation of one workflow version. Every write
+// bumps the version and workflows.id is AUTOINCREMENT, so a deleted
+// workflow's (id, version) is not reused by the next one created; the content
+// hash is computed once at write time and read from the metadata row.
+std::string workflowEtag(const cupb_models::Workflow &workflow, std::string_view representation)
+{
+    std::string etag = "\"";
+    etag += std::to_string(workflow.getId().value_or(0));
+    etag += '-';
+    etag += std::to_string(workflow.getVersion());
+    const std::string hash = workflow.getContentHash();
+    if (!hash.empty()) {
+        etag += '-';
+        etag.append(hash, 0, 32);
+    }
+    etag += '-';
+    etag += representation;
+    etag += '"';
+    return etag;
+}
+
+// If-None-Match uses the weak comparison, so W/ prefixes are ignored
+bool ifNoneMatchHit(std::string_view header, std::string_view etag)
+{
+    for (auto range : std::views::split(header, ',')) {
+        std::string_view candidate(range);
+        while (!candidate.empty() && candidate.front() == ' ') {
+            candidate.remove_prefix(1);
+        }
+        while (!candidate.empty() && candidate.back() == ' ') {
+            candidate.remove_suffix(1);
+        }
+        if (candidate.starts_with("W/")) {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Encodings with a stored variant that the client accepts, most preferred
+// first. Brotli wins ties since its variants are smaller.
+std::vector<services::WorkflowEncodingService::Encoding> acceptedEncodings(std::string_view header)
+{
+    using Encoding = services::WorkflowEncodingService::Encoding;
+
+    double brotliQ = 0;
+    double gzipQ = 0;
+    for (auto range : std::views::split(header, ',')) {
+        std::string_view token(range);
+        double q = 1;
+        if (auto semicolon = token.find(';'); semicolon != std::string_view::npos) {
+            auto qPos = token.find("q=", semicolon);
+            if (qPos != std::string_view::npos) {
+                std::from_chars(token.data() + qPos + 2, token.data() + token.size(), q);
+            }
+            token = token.substr(0, semicolon);
+        }
+        while (!token.empty() && token.front() == ' ') {
+            token.remove_prefix(1);
+        }
+        while (!token.empty() && token.back() == ' ') {
+            token.remove_suffix(1);
+        }
+        if (token == "br") {
+            brotliQ = q;
+        } else if (token == "gzip") {
+            gzipQ = q;
+        } else if (token == "*") {
+            brotliQ = brotliQ == 0 ? q : brotliQ;
+            gzipQ = gzipQ == 0 ? q : gzipQ;
+        }
+    }
+
+    std::vector<Encoding> accepted;
+    if (brotliQ > 0) {
+        accepted.push_back(Encoding::Brotli);
+    }
+    if (gzipQ > 0) {
+        accepted.insert(gzipQ > brotliQ ? accepted.begin() : accepted.end(), Encoding::Gzip);
+    }
+    return accepted;
+}
+
+void writeNodeTypes(cupb_utils::JsonWriter &json, const cupb_utils::WorkflowSummary &summary)
+{
+    json.key("node_types").beginArray();
+    for (const auto &type : summary.nodeTypes) {
+        json.value(type);
+    }
+    json.endArray();
+}
+
+// The 201 body of POST /workflows
+drogon::HttpResponsePtr makeCreatedResponse(const cupb_models::Workflow &workflow,
+                                            const cupb_utils::WorkflowSummary &summary)
+{
+    cupb_utils::JsonWriter json(512 + summary.nodeTypes.size() * 32);
+    json.beginObject().field("message", "Workflow created successfully.").key("workflow").beginObject();
+    cupb_utils::WorkflowJson::writeMetadata(json, workflow);
+    writeNodeTypes(json, summary);
+    json.endObject().endObject();
+    return std::move(json).toResponse(drogon::HttpStatusCode::k201Created);
+}
+
+// Workflows per database read while streaming GET /workflows
+constexpr int kListPageSize = 256;
+
+// What sendPages() needs besides the page source. Everything but the page
+// reads happens on the connection's I/O loop.
+struct PagedStream {
+    std::shared_ptr<cupb_utils::RequestTrace> trace; // Made current while reading
+    std::shared_ptr<void> permit;                    // Released when the stream goes
+    drogon::ResponseStreamPtr out;
+    std::weak_ptr<trantor::TcpConnection> connection;
+    trantor::EventLoop *loop = nullptr;
+    std::optional<std::string> readAhead; // The next page, read but not yet sent
+    bool draining = false;                // Sent bytes are still in the write buffer
+};
+
+// Serializes a GET /workflows listing one page at a time (see sendPages())
+struct WorkflowListStream : PagedStream {
+    std::shared_ptr<services::WorkflowService> service;
+    int64_t userId = 0;
+    int64_t lastId = 0;
+    bool finished = false;
+    cupb_utils::JsonWriter json{kListPageSize * 320};
+
+    void appendPage(const std::vector<cupb_models::Workflow> &page)
+    {
+        for (const auto &workflow : page) {
+            json.beginObject();
+            cupb_utils::WorkflowJson::writeMetadata(json, workflow);
+            json.endObject();
+            lastId = workflow.getId().value_or(lastId);
+        }
+        if (page.size() < static_cast<size_t>(kListPageSize)) {
+            json.endArray().endObject();
+            finished = true;
+        }
+    }
+
+    void readPage()
+    {
+        auto page = service->listWorkflowsPage(userId, lastId, kListPageSize);
+        if (!page) {
+            // The status line is already sent; close the document with the error
+            json.endArray().field("error", page.error().message).endObject();
+            finished = true;
+            return;
+        }
+        appendPage(*page);
+    }
+};
+
+// Workflows with bodies per database read while exporting
+constexpr int kExportPageSize = 16;
+
+// Prepared rows per transaction while importing
+constexpr size_t kImportBatchSize = 64;
+
+// Serializes GET /workflows/export one page of bodies at a time, so a page
+// holds at most kExportPageSize workflows however many the user owns
+struct WorkflowExportStream : PagedStream {
+    std::shared_ptr<services::WorkflowService> service;
+    int64_t userId = 0;
+    int64_t lastId = 0;
+    bool finished = false;
+    cupb_utils::JsonWriter json;
+
+    void appendPage(std::vector<cupb_models::Workflow> &page)
+    {
+        for (auto &workflow : page) {
+            lastId = workflow.getId().value_or(lastId);
+            auto merged = graph::mergeLayout(workflow.getJsonData(), workflow.getLayoutData());
+            json.beginObject();
+            cupb_utils::WorkflowJson::writeMetadata(json, workflow);
+            if (merged) {
+                json.key("json_data").raw(*merged);
+            } else {
+                LOG_ERROR << "Workflow " << lastId << " has a corrupt stored body: " << merged.error();
+                json.field("error", "Stored body is corrupt.");
+            }
+            json.endObject().endLine();
+            // Release the body now rather than when the page goes
+            workflow.setJsonData({});
+            workflow.setLayoutData({});
+        }
+        if (page.size() < static_cast<size_t>(kExportPageSize)) {
+            finished = true;
+        }
+    }
+
+    void readPage()
+    {
+        auto page = service->listWorkflowBodiesPage(userId, lastId, kExportPageSize);
+        if (!page) {
+            // The status line is already sent; report the failure in-band
+            json.beginObject().field("error", page.error().message).endObject().endLine();
+            finished = true;
+            return;
+        }
+        appendPage(*page);
+    }
+};
+
+template <typename Stream>
+void sendReadAhead(const std::shared_ptr<Stream> &stream);
+
+// Reads the next page on a DB worker, so SQLite never runs on the I/O loop,
+// and hands it back to the loop as the read-ahead page
+template <typename Stream>
+void readNextPage(const std::shared_ptr<Stream> &stream)
+{
+    cupb_utils::RequestTrace::Scope traceScope(stream->trace);
+    db::DbWorkerPool::getInstance().runTask([stream]() {
+        stream->readPage();
+        std::string page = stream->json.buffer();
+        stream->json.clearBuffer();
+        stream->loop->queueInLoop([stream, page = std::move(page)]() mutable {
+            stream->readAhead = std::move(page);
+            sendReadAhead(stream);
+        });
+    });
+}
+
+// Ends pacing; the connection outlives the stream when it is kept alive
+template <typename Stream>
+void stopPacing(const std::shared_ptr<Stream> &stream)
+{
+    if (auto connection = stream->connection.lock()) {
+        connection->setWriteCompleteCallback([](const trantor::TcpConnectionPtr &) {});
+    }
+}
+
+// Sends the read-ahead page once the previous one has left the write buffer,
+// and starts reading the one after. The socket paces the reads: while a slow
+// client drains one page, at most one more waits here, so a stream holds two
+// pages however many the user owns and however slowly they are read.
+template <typename Stream>
+void sendReadAhead(const std::shared_ptr<Stream> &stream)
+{
+    if (stream->draining || !stream->readAhead) {
+        return;
+    }
+    stream->draining = true;
+    if (!stream->out->send(*stream->readAhead)) {
+        stopPacing(stream); // Connection closed
+        return;
+    }
+    stream->readAhead.reset();
+    if (stream->finished) {
+        stream->out->close();
+        stopPacing(stream);
+        return;
+    }
+    readNextPage(stream);
+}
+
+// Streams the pages after the first, which the handler has already read.
+// Each page is its own DB task, so a long stream takes turns with other
+// requests' reads.
+template <typename Stream>
+drogon::HttpResponsePtr newPagedResponse(std::shared_ptr<Stream> stream,
+                                         std::weak_ptr<trantor::TcpConnection> connection)
+{
+    return drogon::HttpResponse::newAsyncStreamResponse(
+        [stream, connection = std::move(connection)](drogon::ResponseStreamPtr out) mutable {
+            auto conn = connection.lock();
+            if (!conn) {
+                return;
+            }
+            stream->out = std::move(out);
+            stream->connection = conn;
+            stream->loop = conn->getLoop();
+            stream->loop->runInLoop([stream, conn]() {
+                // Holds the stream until stopPacing() or the connection goes
+                conn->setWriteCompleteCallback([stream](const trantor::TcpConnectionPtr &) {
+                    stream->draining = false;
+                    sendReadAhead(stream);
+                });
+                stream->readAhead = stream->json.buffer();
+                stream->json.clearBuffer();
+                sendReadAhead(stream);
+            });
+        });
+}
+
+} // namespace
+
 WorkflowController::WorkflowController()
+    : workflowService_(std::make_shared<services::WorkflowService>()),
+      graphService_(std::make_shared<services::WorkflowGraphService>(workflowService_)),
+      promptService_(std::make_shared<services::WorkflowPromptService>(workflowService_)),
+      encodingService_(std::make_shared<services::WorkflowEncodingService>(
+          workflowService_, cupb_utils::ThreadTopology::active().encodeWorkers))
 {
+    const auto &topology = cupb_utils::ThreadTopology::active();
+    cupb_utils::ThreadTopology::applyAffinity(importQueue_, topology.importWorkers, topology.pinThreads);
+    const auto &jsonConfig = drogon::app().getCustomConfig();
+    const Json::Value &workflowsConfig = jsonConfig.isNull() || !jsonConfig.isMember("workflows")
+        ? globalWorkflowsConfig
+        : jsonConfig["workflows"];
+    if (workflowsConfig.isMember("max_upload_bytes") && workflowsConfig["max_upload_bytes"].isUInt64()) {
+        maxUploadBytes_ = workflowsConfig["max_upload_bytes"].asUInt64();
+    }
+
     LOG_DEBUG << "WorkflowController constructed";
 }
 
@@ -19,16 +374,35 @@ void WorkflowController::getWorkflows(
     std::function<void(const drogon::HttpResponsePtr &)> &&callback)
 {
     LOG_DEBUG << "Handling GET /workflows request";
-    
+
     // Get the user ID from the request attributes (set by JwtAuthFilter)
     auto userId = req->attributes()->get<int64_t>("user_id");
-    
-    // For now, just return a placeholder response
-    Json::Value response;
-    response["message"] = "List workflows functionality coming soon";
-    response["workflows"] = Json::Value(Json::arrayValue);
-    
-    auto resp = drogon::HttpResponse::newHttpJsonResponse(response);
+
+    // The first page is read up front so that a failing database still gets
+    // a proper error status
+    auto firstPage = workflowService_->listWorkflowsPage(userId, 0, kListPageSize);
+    if (!firstPage) {
+        callback(makeErrorResponse(firstPage.error().message, firstPage.error().statusCode));
+        return;
+    }
+
+    auto stream = std::make_shared<WorkflowListStream>();
+    stream->service = workflowService_;
+    stream->trace = cupb_utils::RequestTrace::current();
+    stream->userId = userId;
+    stream->json.beginObject().key("workflows").beginArray();
+    stream->appendPage(*firstPage);
+
+    // Short listings fit in one page and go out with a Content-Length
+    if (stream->finished) {
+        callback(std::move(stream->json).toResponse());
+        return;
+    }
+
+    // Keep the workflow_read slot until the last page is sent
+    stream->permit = cupb_utils::LoadShedder::holdPermit(req);
+    auto resp = newPagedResponse(stream, req->getConnectionPtr());
+    resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
     callback(resp);
 }
 
@@ -37,112 +411,509 @@ void WorkflowController::createWorkflow(
     std::function<void(const drogon::HttpResponsePtr &)> &&callback)
 {
     LOG_DEBUG << "Handling POST /workflows request";
-    auto jsonBodyPtr = req->getJsonObject();
-    
-    if (!jsonBodyPtr)
-    {
-        Json::Value errorJson;
-        errorJson["error"] = "Invalid JSON payload.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
+
+    if (req->body().size() > maxUploadBytes_) {
+        callback(makeErrorResponse(uploadTooLargeMessage(maxUploadBytes_), 413));
+        return;
+    }
+
+    // Parse the raw body with simdjson instead of req->getJsonObject(), which
+    // would build a full jsoncpp DOM of the graph
+    auto upload = cupb_utils::WorkflowIngest::parseUpload(req->body(), true);
+    if (!upload) {
+        callback(makeErrorResponse(upload.error(), 400));
         return;
     }
-    
+
+    // Get the user ID from the request attributes (set by JwtAuthFilter)
+    auto userId = req->attributes()->get<int64_t>("user_id");
+
+    auto result = workflowService_->createWorkflow(userId, *upload);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+
+    encodingService_->scheduleEncode(result->getId().value_or(0), userId);
+    callback(makeCreatedResponse(*result, upload->summary));
+}
+
+std::vector<drogon::HttpResponsePtr> WorkflowController::createWorkflows(
+    int64_t userId,
+    const std::vector<std::string_view> &bodies)
+{
+    std::vector<drogon::HttpResponsePtr> responses(bodies.size());
+    std::vector<cupb_db_models::Workflow> rows;
+    std::vector<cupb_utils::WorkflowSummary> summaries;
+    std::vector<size_t> rowIndexes;
+
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i].size() > maxUploadBytes_) {
+            responses[i] = makeErrorResponse(uploadTooLargeMessage(maxUploadBytes_), 413);
+            continue;
+        }
+        auto upload = cupb_utils::WorkflowIngest::parseUpload(bodies[i], true);
+        if (!upload) {
+            responses[i] = makeErrorResponse(upload.error(), 400);
+            continue;
+        }
+        auto prepared = workflowService_->prepareNewWorkflow(userId, *upload);
+        if (!prepared) {
+            responses[i] = makeErrorResponse(prepared.error().message, prepared.error().statusCode);
+            continue;
+        }
+        rows.push_back(std::move(*prepared));
+        summaries.push_back(std::move(upload->summary));
+        rowIndexes.push_back(i);
+    }
+
+    if (rows.empty()) {
+        return responses;
+    }
+
+    auto inserted = workflowService_->insertWorkflows(rows);
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (!inserted) {
+            responses[rowIndexes[r]] = makeErrorResponse(inserted.error().message, inserted.error().statusCode);
+            continue;
+        }
+        encodingService_->scheduleEncode(rows[r].id.value_or(0), userId);
+        auto workflow = workflowService_->dbModelToWorkflowModel(std::move(rows[r]));
+        responses[rowIndexes[r]] = makeCreatedResponse(workflow, summaries[r]);
+    }
+    return responses;
+}
+
+void WorkflowController::exportWorkflows(
+    const drogon::HttpRequestPtr &req,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    LOG_DEBUG << "Handling GET /workflows/export request";
+
     // Get the user ID from the request attributes (set by JwtAuthFilter)
     auto userId = req->attributes()->get<int64_t>("user_id");
-    
-    // For now, just return a placeholder response
-    Json::Value response;
-    response["message"] = "Create workflow functionality coming soon";
-    response["workflow"] = Json::Value(Json::objectValue);
-    response["workflow"]["id"] = 1;  // Placeholder ID
-    response["workflow"]["name"] = "New Workflow";
-    
-    auto resp = drogon::HttpResponse::newHttpJsonResponse(response);
-    resp->setStatusCode(drogon::HttpStatusCode::k201Created);
+
+    // Read the first page up front so that a failing database gets a real status
+    auto firstPage = workflowService_->listWorkflowBodiesPage(userId, 0, kExportPageSize);
+    if (!firstPage) {
+        callback(makeErrorResponse(firstPage.error().message, firstPage.error().statusCode));
+        return;
+    }
+
+    auto stream = std::make_shared<WorkflowExportStream>();
+    stream->service = workflowService_;
+    stream->trace = cupb_utils::RequestTrace::current();
+    stream->userId = userId;
+    stream->appendPage(*firstPage);
+    stream->permit = cupb_utils::LoadShedder::holdPermit(req);
+
+    auto resp = newPagedResponse(stream, req->getConnectionPtr());
+    resp->setContentTypeString("application/x-ndjson");
+    resp->addHeader("Content-Disposition", "attachment; filename=\"workflows.ndjson\"");
     callback(resp);
 }
 
-void WorkflowController::getWorkflowById(
+void WorkflowController::importWorkflows(
     const drogon::HttpRequestPtr &req,
     std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+{
+    LOG_DEBUG << "Handling POST /workflows/import request";
+
+    // Get the user ID from the request attributes (set by JwtAuthFilter)
+    auto userId = req->attributes()->get<int64_t>("user_id");
+
+    // A large import takes a while; keep it off the I/O thread. The request
+    // keeps its body alive, spooled to disk by Drogon when it is large.
+    importQueue_.runTaskInQueue([this, req, userId, callback = std::move(callback),
+                                 trace = cupb_utils::RequestTrace::current()]() {
+        cupb_utils::RequestTrace::Scope traceScope(trace);
+        std::string_view body = req->body();
+        cupb_utils::JsonWriter results(4096);
+        size_t imported = 0;
+        size_t failed = 0;
+
+        std::vector<cupb_db_models::Workflow> batch;
+        std::vector<size_t> batchLines;
+        auto reportError = [&](size_t line, std::string_view message) {
+            results.beginObject().field("line", line).field("error", message).endObject().endLine();
+            ++failed;
+        };
+        auto flush = [&]() {
+            if (batch.empty()) {
+                return;
+            }
+            auto inserted = workflowService_->insertWorkflows(batch);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (!inserted) {
+                    reportError(batchLines[i], inserted.error().message);
+                    continue;
+                }
+                const int64_t id = batch[i].id.value_or(0);
+                results.beginObject().field("line", batchLines[i]).field("id", id).endObject().endLine();
+                encodingService_->scheduleEncode(id, userId);
+                ++imported;
+            }
+            batch.clear();
+            batchLines.clear();
+        };
+
+        size_t lineNumber = 0;
+        while (!body.empty()) {
+            size_t end = body.find('\n');
+            std::string_view line = body.substr(0, end);
+            body.remove_prefix(end == std::string_view::npos ? body.size() : end + 1);
+            ++lineNumber;
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.find_first_not_of(" \t") == std::string_view::npos) {
+                continue;
+            }
+            if (line.size() > maxUploadBytes_) {
+                reportError(lineNumber, uploadTooLargeMessage(maxUploadBytes_));
+                continue;
+            }
+
+            // prepareNewWorkflow copies out of the ingest scratch buffer, so
+            // the next line can be parsed while this one waits in the batch
+            auto upload = cupb_utils::WorkflowIngest::parseUpload(line, true);
+            if (!upload) {
+                reportError(lineNumber, upload.error());
+                continue;
+            }
+            auto prepared = workflowService_->prepareNewWorkflow(userId, *upload);
+            if (!prepared) {
+                reportError(lineNumber, prepared.error().message);
+                continue;
+            }
+            batch.push_back(std::move(*prepared));
+            batchLines.push_back(lineNumber);
+            if (batch.size() >= kImportBatchSize) {
+                flush();
+            }
+        }
+        flush();
+
+        LOG_INFO << "User " << userId << " imported " << imported << " workflows, " << failed << " failed";
+        results.beginObject().field("imported", imported).field("failed", failed).endObject().endLine();
+
+        auto resp = drogon::HttpResponse::newHttpResponse();
+        resp->setContentTypeString("application/x-ndjson");
+        resp->setBody(std::move(results).take());
+        callback(resp);
+    });
+}
+
+void WorkflowController::getWorkflowById(
+    const drogon::HttpRequestPtr &req,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    const std::string &id)
 {
     LOG_DEBUG << "Handling GET /workflows/{id} request";
-    
-    // Get the workflow ID from the path
-    auto workflowId = req->getParameter("id");
-    
+
+    auto workflowId = parseWorkflowId(id);
+    if (!workflowId) {
+        callback(makeErrorResponse("Invalid workflow id.", 400));
+        return;
+    }
+
     // Get the user ID from the request attributes (set by JwtAuthFilter)
     auto userId = req->attributes()->get<int64_t>("user_id");
-    
-    // For now, just return a placeholder response
-    Json::Value response;
-    response["message"] = "Get workflow by ID functionality coming soon";
-    response["workflow"] = Json::Value(Json::objectValue);
-    response["workflow"]["id"] = workflowId;
-    response["workflow"]["name"] = "Sample Workflow";
-    
-    auto resp = drogon::HttpResponse::newHttpJsonResponse(response);
+
+    // ?parts=graph, ?parts=layout or ?parts=graph,layout return the stored parts
+    // separately; without it the two are merged back into json_data
+    const std::string &partsParam = req->getParameter("parts");
+    bool wantGraph = partsParam.empty();
+    bool wantLayout = partsParam.empty();
+    for (std::string_view part : std::views::split(std::string_view(partsParam), ',') |
+                                     std::views::transform([](auto range) { return std::string_view(range); })) {
+        if (part == "graph") {
+            wantGraph = true;
+        } else if (part == "layout") {
+            wantLayout = true;
+        } else {
+            callback(makeErrorResponse("parts must list graph and/or layout.", 400));
+            return;
+        }
+    }
+    auto parts = wantGraph && wantLayout ? services::WorkflowService::BodyParts::Both
+                 : wantGraph             ? services::WorkflowService::BodyParts::Graph
+                                         : services::WorkflowService::BodyParts::Layout;
+    std::string_view representation = partsParam.empty() ? "json"
+                                      : !wantLayout      ? "graph"
+                                      : !wantGraph       ? "layout"
+                                                         : "parts";
+
+    // Precompressed variants exist only for the default (merged) representation
+    std::vector<services::WorkflowEncodingService::Encoding> accepted;
+    if (partsParam.empty()) {
+        accepted = acceptedEncodings(req->getHeader("accept-encoding"));
+    }
+
+    // Revalidation and precompressed reads only touch the metadata row and, on
+    // a variant hit, the compressed bytes; the bodies are never loaded
+    const std::string &ifNoneMatch = req->getHeader("if-none-match");
+    if (!ifNoneMatch.empty() || !accepted.empty()) {
+        auto metadata = workflowService_->getWorkflowMetadata(*workflowId, userId);
+        if (!metadata) {
+            callback(makeErrorResponse(metadata.error().message, metadata.error().statusCode));
+            return;
+        }
+
+        if (!ifNoneMatch.empty()) {
+            // Each encoding is a distinct representation with its own strong ETag
+            std::vector<std::string> etags{workflowEtag(*metadata, representation)};
+            for (auto encoding : accepted) {
+                etags.push_back(workflowEtag(
+                    *metadata, std::string(representation) + "-" +
+                                   std::string(services::WorkflowEncodingService::encodingName(encoding))));
+            }
+            auto hit = std::find_if(etags.begin(), etags.end(), [&](const std::string &etag) {
+                return ifNoneMatchHit(ifNoneMatch, etag);
+            });
+            if (hit != etags.end()) {
+                auto resp = drogon::HttpResponse::newHttpResponse();
+                resp->setStatusCode(drogon::k304NotModified);
+                resp->addHeader("ETag", *hit);
+                resp->addHeader("Cache-Control", "private, no-cache");
+                if (partsParam.empty()) {
+                    resp->addHeader("Vary", "Accept-Encoding");
+                }
+                callback(resp);
+                return;
+            }
+        }
+
+        if (auto encoded = encodingService_->findEncoded(*metadata, accepted)) {
+            const auto encodingName = services::WorkflowEncodingService::encodingName(encoded->encoding);
+            auto resp = drogon::HttpResponse::newHttpResponse();
+            resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+            resp->setBody(std::move(encoded->body));
+            resp->addHeader("Content-Encoding", std::string(encodingName));
+            resp->addHeader("Vary", "Accept-Encoding");
+            resp->addHeader("ETag", workflowEtag(*metadata, std::string(representation) + "-" +
+                                                                std::string(encodingName)));
+            resp->addHeader("Cache-Control", "private, no-cache");
+            callback(resp);
+            return;
+        }
+    }
+
+    auto result = workflowService_->getWorkflowById(*workflowId, userId, parts);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+
+    // Splice the stored bodies into the metadata verbatim
+    const std::string &graphData = result->getJsonData();
+    const std::string &layoutData = result->getLayoutData();
+    // Workflows in API format have no layout
+    std::string_view layoutJson = layoutData.empty() ? std::string_view("null") : std::string_view(layoutData);
+    std::string body;
+    cupb_utils::RequestTrace::Phase serializePhase("serialize.workflow");
+    if (partsParam.empty()) {
+        auto merged = graph::mergeLayout(graphData, layoutData);
+        if (!merged) {
+            LOG_ERROR << "Workflow " << *workflowId << " has a corrupt stored body: " << merged.error();
+            callback(makeErrorResponse("Failed to load workflow.", 500));
+            return;
+        }
+        body = cupb_utils::WorkflowJson::documentBody(*result, {{"json_data", *merged}});
+    } else if (wantGraph && wantLayout) {
+        body = cupb_utils::WorkflowJson::documentBody(*result, {{"graph", graphData}, {"layout", layoutJson}});
+    } else if (wantGraph) {
+        body = cupb_utils::WorkflowJson::documentBody(*result, {{"graph", graphData}});
+    } else {
+        body = cupb_utils::WorkflowJson::documentBody(*result, {{"layout", layoutJson}});
+    }
+    serializePhase.end();
+
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    resp->setBody(std::move(body));
+    resp->addHeader("ETag", workflowEtag(*result, representation));
+    resp->addHeader("Cache-Control", "private, no-cache");
+    if (partsParam.empty()) {
+        resp->addHeader("Vary", "Accept-Encoding");
+    }
     callback(resp);
 }
 
 void WorkflowController::updateWorkflow(
     const drogon::HttpRequestPtr &req,
-    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    const std::string &id)
 {
     LOG_DEBUG << "Handling PUT /workflows/{id} request";
-    
-    // Get the workflow ID from the path
-    auto workflowId = req->getParameter("id");
-    
+
+    auto workflowId = parseWorkflowId(id);
+    if (!workflowId) {
+        callback(makeErrorResponse("Invalid workflow id.", 400));
+        return;
+    }
+
+    if (req->body().size() > maxUploadBytes_) {
+        callback(makeErrorResponse(uploadTooLargeMessage(maxUploadBytes_), 413));
+        return;
+    }
+
     // Get the user ID from the request attributes (set by JwtAuthFilter)
     auto userId = req->attributes()->get<int64_t>("user_id");
-    
-    auto jsonBodyPtr = req->getJsonObject();
-    
-    if (!jsonBodyPtr)
-    {
-        Json::Value errorJson;
-        errorJson["error"] = "Invalid JSON payload.";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(errorJson);
-        resp->setStatusCode(drogon::HttpStatusCode::k400BadRequest);
-        callback(resp);
+
+    auto upload = cupb_utils::WorkflowIngest::parseUpload(req->body(), false);
+    if (!upload) {
+        callback(makeErrorResponse(upload.error(), 400));
         return;
     }
-    
-    // For now, just return a placeholder response
-    Json::Value response;
-    response["message"] = "Update workflow functionality coming soon";
-    response["workflow"] = Json::Value(Json::objectValue);
-    response["workflow"]["id"] = workflowId;
-    response["workflow"]["name"] = "Updated Workflow";
-    
-    auto resp = drogon::HttpResponse::newHttpJsonResponse(response);
-    callback(resp);
+
+    auto result = workflowService_->updateWorkflow(*workflowId, userId, *upload);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+
+    encodingService_->scheduleEncode(*workflowId, userId);
+
+    cupb_utils::JsonWriter json(512 + upload->summary.nodeTypes.size() * 32);
+    json.beginObject().field("message", "Workflow updated successfully.").key("workflow").beginObject();
+    cupb_utils::WorkflowJson::writeMetadata(json, *result);
+    if (upload->jsonData) {
+        writeNodeTypes(json, upload->summary);
+    }
+    json.endObject().endObject();
+
+    callback(std::move(json).toResponse());
 }
 
 void WorkflowController::deleteWorkflow(
     const drogon::HttpRequestPtr &req,
-    std::function<void(const drogon::HttpResponsePtr &)> &&callback)
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    const std::string &id)
 {
     LOG_DEBUG << "Handling DELETE /workflows/{id} request";
-    
-    // Get the workflow ID from the path
-    auto workflowId = req->getParameter("id");
-    
+
+    auto workflowId = parseWorkflowId(id);
+    if (!workflowId) {
+        callback(makeErrorResponse("Invalid workflow id.", 400));
+        return;
+    }
+
     // Get the user ID from the request attributes (set by JwtAuthFilter)
     auto userId = req->attributes()->get<int64_t>("user_id");
-    
-    // For now, just return a placeholder response
-    Json::Value response;
-    response["message"] = "Workflow deleted successfully.";
-    response["id"] = workflowId;
-    
-    auto resp = drogon::HttpResponse::newHttpJsonResponse(response);
-    callback(resp);
+
+    auto result = workflowService_->deleteWorkflow(*workflowId, userId);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+
+    graphService_->invalidate(*workflowId);
+    promptService_->invalidate(*workflowId);
+
+    cupb_utils::JsonWriter json(64);
+    json.beginObject().field("message", "Workflow deleted successfully.").field("id", *workflowId).endObject();
+
+    callback(std::move(json).toResponse());
+}
+
+void WorkflowController::getWorkflowAnalysis(
+    const drogon::HttpRequestPtr &req,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    const std::string &id)
+{
+    LOG_DEBUG << "Handling GET /workflows/{id}/analysis request";
+
+    auto workflowId = parseWorkflowId(id);
+    if (!workflowId) {
+        callback(makeErrorResponse("Invalid workflow id.", 400));
+        return;
+    }
+
+    // Get the user ID from the request attributes (set by JwtAuthFilter)
+    auto userId = req->attributes()->get<int64_t>("user_id");
+
+    auto result = graphService_->getAnalysis(*workflowId, userId);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+    const auto &analysis = *result->analysis;
+
+    cupb_utils::JsonWriter json(256 + analysis.nodeCount * 16 + analysis.danglingLinks.size() * 96);
+    json.beginObject()
+        .field("workflow_id", *workflowId)
+        .field("version", result->version)
+        .field("node_count", analysis.nodeCount)
+        .field("link_count", analysis.linkCount)
+        .field("has_cycle", analysis.hasCycle);
+
+    json.key("topological_order").beginArray();
+    for (const auto &node : analysis.topologicalOrder) {
+        json.value(node);
+    }
+    json.endArray();
+    json.key("cycle_nodes").beginArray();
+    for (const auto &node : analysis.cycleNodes) {
+        json.value(node);
+    }
+    json.endArray();
+    json.key("dangling_links").beginArray();
+    for (const auto &link : analysis.danglingLinks) {
+        json.beginObject()
+            .field("link_id", link.linkId)
+            .field("origin_node", link.originNode)
+            .field("target_node", link.targetNode)
+            .field("missing_origin", link.missingOrigin)
+            .field("missing_target", link.missingTarget)
+            .endObject();
+    }
+    json.endArray();
+    json.key("type_counts").beginObject();
+    for (const auto &[type, count] : analysis.typeCounts) {
+        json.field(type, count);
+    }
+    json.endObject().endObject();
+
+    callback(std::move(json).toResponse());
+}
+
+void WorkflowController::getWorkflowPrompt(
+    const drogon::HttpRequestPtr &req,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    const std::string &id)
+{
+    LOG_DEBUG << "Handling GET /workflows/{id}/prompt request";
+
+    auto workflowId = parseWorkflowId(id);
+    if (!workflowId) {
+        callback(makeErrorResponse("Invalid workflow id.", 400));
+        return;
+    }
+
+    // Get the user ID from the request attributes (set by JwtAuthFilter)
+    auto userId = req->attributes()->get<int64_t>("user_id");
+
+    auto result = promptService_->getPrompt(*workflowId, userId);
+    if (!result) {
+        callback(makeErrorResponse(result.error().message, result.error().statusCode));
+        return;
+    }
+
+    // The cached prompt is already serialized; splice it in as-is
+    const std::string &prompt = *result->prompt;
+    cupb_utils::JsonWriter json(prompt.size() + 64);
+    json.beginObject()
+        .field("workflow_id", *workflowId)
+        .field("version", result->version)
+        .key("prompt")
+        .raw(prompt)
+        .endObject();
+
+    callback(std::move(json).toResponse());
 }
 
 } // namespace controllers
 } // namespace app
-} // namespace comfyui_plus_backend
\ No newline at end of file
+} // namespace comfyui_plus_backend
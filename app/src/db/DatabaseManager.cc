@@ -1,8 +1,18 @@
 // app/src/db/DatabaseManager.cc
 #include "comfyui_plus_backend/db/DatabaseManager.h"
+#include "comfyui_plus_backend/db/DbWorkerPool.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include "comfyui_plus_backend/utils/PasswordHashPool.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
 #include <drogon/drogon.h>
+#include <sqlite3.h>
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
-#include <sstream> // Added for std::stringstream
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace comfyui_plus_backend
 {
@@ -11,6 +21,136 @@ namespace app
 namespace db
 {
 
+namespace
+{
+
+// Recorded in PRAGMA user_version once every migration below has run
+//   1: created_at/updated_at hold int64 epoch microseconds instead of local-time text
+//   2: workflows.id is AUTOINCREMENT, so ids of deleted workflows are not reused
+constexpr int kSchemaVersion = 2;
+
+// How long a connection waits for another connection's write lock
+constexpr int kBusyTimeoutMs = 5000;
+
+// Counts every statement a connection runs and the time it took, and adds
+// it to the trace of the request it ran for
+int traceStatement(unsigned, void *, void *, void *elapsedNanos)
+{
+    const auto elapsed = static_cast<uint64_t>(*static_cast<sqlite3_int64 *>(elapsedNanos));
+    utils::Metrics::increment(utils::Metrics::Counter::DbQueries);
+    utils::Metrics::increment(utils::Metrics::Counter::DbQueryNanos, elapsed);
+    if (const auto &trace = utils::RequestTrace::current()) {
+        const auto end = utils::RequestTrace::Clock::now();
+        trace->record("db.query", end - std::chrono::nanoseconds(elapsed), end);
+    }
+    return 0;
+}
+
+// Tables rebuilt by a migration: TEXT timestamps before version 1, and
+// workflows without AUTOINCREMENT before version 2
+constexpr const char *kRebuiltTables[] = {"users", "workflows"};
+
+std::string legacyTableName(const std::string &table)
+{
+    return table + "_legacy_v0";
+}
+
+// Converts a "YYYY-MM-DD HH:MM:SS[.ffffff]" local-time column to epoch
+// microseconds without losing the fractional part
+std::string legacyTimestampToMicros(const std::string &column)
+{
+    return "COALESCE(CAST(strftime('%s', " + column + ", 'utc') AS INTEGER) * 1000000 + "
+           "CASE WHEN instr(" + column + ", '.') > 0 THEN CAST(substr(substr(" + column + ", instr(" +
+           column + ", '.') + 1) || '000000', 1, 6) AS INTEGER) ELSE 0 END, 0)";
+}
+
+// A plain sqlite3 handle for schema changes sqlite_orm cannot express; its
+// sync_schema() would drop and recreate a table whose column type changed
+class MigrationConnection
+{
+public:
+    explicit MigrationConnection(const std::string &dbPath)
+    {
+        if (sqlite3_open(dbPath.c_str(), &db_) != SQLITE_OK) {
+            std::string message = db_ ? sqlite3_errmsg(db_) : "out of memory";
+            sqlite3_close(db_);
+            throw std::runtime_error("Cannot open database for migration: " + message);
+        }
+    }
+
+    ~MigrationConnection() { sqlite3_close(db_); }
+
+    MigrationConnection(const MigrationConnection&) = delete;
+    MigrationConnection& operator=(const MigrationConnection&) = delete;
+
+    void exec(const std::string &sql)
+    {
+        char *error = nullptr;
+        if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+            std::string message = error ? error : "unknown error";
+            sqlite3_free(error);
+            throw std::runtime_error("Migration statement failed: " + message + " (" + sql + ")");
+        }
+    }
+
+    int userVersion()
+    {
+        int version = 0;
+        sqlite3_exec(
+            db_, "PRAGMA user_version",
+            [](void *out, int, char **values, char **) {
+                *static_cast<int *>(out) = values[0] ? std::atoi(values[0]) : 0;
+                return 0;
+            },
+            &version, nullptr);
+        return version;
+    }
+
+    // Column name and declared type of each column, empty if the table is missing
+    std::vector<std::pair<std::string, std::string>> columns(const std::string &table)
+    {
+        std::vector<std::pair<std::string, std::string>> result;
+        sqlite3_exec(
+            db_, ("PRAGMA table_info(" + table + ")").c_str(),
+            [](void *out, int, char **values, char **) {
+                static_cast<std::vector<std::pair<std::string, std::string>> *>(out)->emplace_back(
+                    values[1] ? values[1] : "", values[2] ? values[2] : "");
+                return 0;
+            },
+            &result, nullptr);
+        return result;
+    }
+
+    // The CREATE TABLE statement SQLite keeps for table, empty if it is missing
+    std::string tableSql(const std::string &table)
+    {
+        std::string sql;
+        sqlite3_exec(
+            db_, ("SELECT sql FROM sqlite_master WHERE type = 'table' AND name = '" + table + "'").c_str(),
+            [](void *out, int, char **values, char **) {
+                *static_cast<std::string *>(out) = values[0] ? values[0] : "";
+                return 0;
+            },
+            &sql, nullptr);
+        return sql;
+    }
+
+    std::string columnType(const std::string &table, const std::string &column)
+    {
+        for (const auto &[name, type] : columns(table)) {
+            if (name == column) {
+                return type;
+            }
+        }
+        return {};
+    }
+
+private:
+    sqlite3 *db_ = nullptr;
+};
+
+} // namespace
+
 // Initialize the thread_local storage
 thread_local DatabaseManager::ThreadLocalData DatabaseManager::threadLocalData_;
 
@@ -48,10 +188,16 @@ bool DatabaseManager::initialize(const std::string& dbPath) {
         
         // Initialize the main storage
         dbPath_ = dbPath;
+        migrateBeforeSync();
         mainStorage_ = std::make_unique<comfyui_plus_backend::app::db::Storage>(createStorage(dbPath_));
         
         // Create tables if they don't exist
         syncSchema();
+        migrateAfterSync();
+
+        // Persistent: readers on the per-thread connections no longer block
+        // behind a writer, and a writer no longer waits for readers
+        MigrationConnection(dbPath_).exec("PRAGMA journal_mode = WAL");
         
         initialized_ = true;
         LOG_INFO << "DatabaseManager initialized with database: " << dbPath_;
@@ -71,12 +217,19 @@ comfyui_plus_backend::app::db::Storage& DatabaseManager::getStorage() {
     if (std::this_thread::get_id() != std::thread::id()) {
         // Initialize thread-local storage if not already done
         if (!threadLocalData_.storage) {
-            // Convert the thread ID to a string representation
-            std::stringstream ss;
-            ss << std::this_thread::get_id();
-            LOG_DEBUG << "Creating thread-local database connection for thread ID: " << ss.str();
+            // The log line carries the thread id
+            LOG_DEBUG << "Creating thread-local database connection";
             
             threadLocalData_.storage = std::make_unique<comfyui_plus_backend::app::db::Storage>(createStorage(dbPath_));
+
+            threadLocalData_.storage->on_open = [](sqlite3 *db) {
+                sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE, traceStatement, nullptr);
+            };
+
+            // Held open for the thread's lifetime; otherwise sqlite_orm opens
+            // the file and reads the schema again for every statement
+            threadLocalData_.storage->open_forever();
+            threadLocalData_.storage->busy_timeout(kBusyTimeoutMs);
         }
         return *threadLocalData_.storage;
     }
@@ -105,6 +258,127 @@ bool DatabaseManager::isInitialized() const {
     return initialized_;
 }
 
+void DatabaseManager::warmUpConnection() {
+    using namespace sqlite_orm;
+    using models::User;
+    using models::Workflow;
+
+    try {
+        auto& storage = getStorage();
+
+        // Each lookup misses on purpose: it walks the index it would use from
+        // the root without reading any rows
+        storage.get_optional<User>(int64_t{-1});
+        storage.count<User>(where(c(&User::username) == std::string()));
+        storage.count<User>(where(c(&User::email) == std::string()));
+        storage.select(&Workflow::userId, where(c(&Workflow::id) == int64_t{-1}));
+        storage.select(&Workflow::id, where(c(&Workflow::userId) == int64_t{-1}), sqlite_orm::limit(1));
+    } catch (const std::exception& e) {
+        LOG_ERROR << "Error warming up database connection: " << e.what();
+    }
+}
+
+void DatabaseManager::warmUpAllConnections() {
+    const size_t ioLoops = drogon::app().getThreadNum();
+    auto& dbWorkers = DbWorkerPool::getInstance();
+    auto& hashWorkers = utils::PasswordHashPool::getInstance();
+
+    const size_t threads = ioLoops + dbWorkers.threadCount() + hashWorkers.threadCount();
+    auto remaining = std::make_shared<std::atomic<size_t>>(threads);
+    const auto started = std::chrono::steady_clock::now();
+
+    auto warmUp = [this, remaining, started, threads]() {
+        warmUpConnection();
+        if (remaining->fetch_sub(1) == 1) {
+            warm_.store(true, std::memory_order_release);
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started);
+            LOG_INFO << "Database connections warm on " << threads << " threads after "
+                     << elapsed.count() << " ms";
+        }
+    };
+
+    for (size_t i = 0; i < ioLoops; ++i) {
+        drogon::app().getIOLoop(i)->queueInLoop(warmUp);
+    }
+    dbWorkers.runOnEachWorker(warmUp);
+    hashWorkers.runOnEachWorker(warmUp);
+}
+
+bool DatabaseManager::isWarm() const {
+    return warm_.load(std::memory_order_acquire);
+}
+
+void DatabaseManager::migrateBeforeSync() {
+    MigrationConnection db(dbPath_);
+    if (db.userVersion() >= kSchemaVersion) {
+        return;
+    }
+
+    // Move tables with TEXT timestamps, or a workflows table without
+    // AUTOINCREMENT, aside; sync_schema() then creates them afresh and
+    // migrateAfterSync() copies the rows across. legacy_alter_table keeps
+    // other tables' foreign keys pointing at the original names rather than
+    // following the rename.
+    db.exec("PRAGMA foreign_keys = OFF");
+    db.exec("PRAGMA legacy_alter_table = ON");
+    db.exec("BEGIN");
+    for (const std::string table : kRebuiltTables) {
+        if (!db.columns(legacyTableName(table)).empty()) {
+            continue;
+        }
+        auto type = db.columnType(table, "created_at");
+        if (!type.empty() && type != "INTEGER") {
+            LOG_INFO << "Migrating " << table << " timestamps from " << type << " to epoch microseconds";
+            db.exec("ALTER TABLE " + table + " RENAME TO " + legacyTableName(table));
+        } else if (table == "workflows" && !type.empty() &&
+                   db.tableSql(table).find("AUTOINCREMENT") == std::string::npos) {
+            LOG_INFO << "Migrating " << table << " ids to AUTOINCREMENT";
+            db.exec("ALTER TABLE " + table + " RENAME TO " + legacyTableName(table));
+        }
+    }
+    db.exec("COMMIT");
+}
+
+void DatabaseManager::migrateAfterSync() {
+    MigrationConnection db(dbPath_);
+    if (db.userVersion() >= kSchemaVersion) {
+        return;
+    }
+
+    db.exec("PRAGMA foreign_keys = OFF");
+    db.exec("BEGIN");
+    for (const std::string table : kRebuiltTables) {
+        const std::string legacy = legacyTableName(table);
+        auto legacyColumns = db.columns(legacy);
+        if (legacyColumns.empty()) {
+            continue;
+        }
+
+        // Copy the columns both versions share; ones added since keep their defaults
+        std::string targetList;
+        std::string sourceList;
+        for (const auto &[name, type] : legacyColumns) {
+            if (db.columnType(table, name).empty()) {
+                continue;
+            }
+            if (!targetList.empty()) {
+                targetList += ", ";
+                sourceList += ", ";
+            }
+            targetList += name;
+            const bool textTimestamp = (name == "created_at" || name == "updated_at") && type != "INTEGER";
+            sourceList += textTimestamp ? legacyTimestampToMicros(name) : name;
+        }
+        // Explicit ids also move an AUTOINCREMENT table's sequence past them
+        db.exec("INSERT INTO " + table + " (" + targetList + ") SELECT " + sourceList + " FROM " + legacy);
+        db.exec("DROP TABLE " + legacy);
+        LOG_INFO << "Migrated " << table << " to schema version " << kSchemaVersion;
+    }
+    db.exec("PRAGMA user_version = " + std::to_string(kSchemaVersion));
+    db.exec("COMMIT");
+}
+
 void DatabaseManager::syncSchema() {
     if (!mainStorage_) {
         throw std::runtime_error("Storage not initialized");
@@ -0,0 +1,28 @@
+// app/src/db/DbWorkerPool.cc
+#include "comfyui_plus_backend/db/DbWorkerPool.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace db
+{
+
+DbWorkerPool& DbWorkerPool::getInstance()
+{
+    static DbWorkerPool instance;
+    return instance;
+}
+
+DbWorkerPool::DbWorkerPool()
+    : utils::WorkerPool("DbWorker",
+                        utils::ThreadTopology::active().dbWorkers,
+                        utils::Metrics::Counter::DbWorkerWaitNanos,
+                        utils::Metrics::Counter::DbWorkerTasks,
+                        "wait.db_worker")
+{
+}
+
+} // namespace db
+} // namespace app
+} // namespace comfyui_plus_backend
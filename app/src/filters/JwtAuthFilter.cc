@@ -1,6 +1,8 @@
 // app/src/filters/JwtAuthFilter.cc
 #include "comfyui_plus_backend/filters/JwtAuthFilter.h"
 #include "comfyui_plus_backend/services/JwtService.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
 #include <drogon/drogon.h>
 #include <memory>
 
@@ -42,11 +44,10 @@ void JwtAuthFilter::doFilter(const drogon::HttpRequestPtr& req,
     // Extract token (remove "Bearer " prefix)
     token = authHeader.substr(7);
     
-    // Initialize JWT service
-    services::JwtService jwtService;
-    
     // Verify token
-    auto decodedToken = jwtService.verifyToken(token);
+    utils::RequestTrace::Phase phase("auth.jwt");
+    auto decodedToken = jwtService_.verifyToken(token);
+    phase.end();
     if (!decodedToken) {
         LOG_WARN << "Invalid JWT token for path: " << path;
         auto resp = drogon::HttpResponse::newHttpJsonResponse({{"error", "Unauthorized: Invalid token"}});
@@ -56,7 +57,7 @@ void JwtAuthFilter::doFilter(const drogon::HttpRequestPtr& req,
     }
     
     // Extract user ID from token
-    auto userId = jwtService.getUserIdFromToken(*decodedToken);
+    auto userId = jwtService_.getUserIdFromToken(*decodedToken);
     if (!userId) {
         LOG_WARN << "JWT token valid but user_id claim not found for path: " << path;
         auto resp = drogon::HttpResponse::newHttpJsonResponse({{"error", "Unauthorized: Invalid token format"}});
@@ -82,8 +83,8 @@ void JwtAuthFilter::doFilter(const drogon::HttpRequestPtr& req,
 }
 
 bool JwtAuthFilter::isProtectedPath(const std::string& path) {
-    // Check if the path starts with "/workflows" or is "/auth/me"
-    return path.find("/workflows") == 0 || path == "/auth/me";
+    // Check if the path starts with "/workflows" or is "/auth/me" or "/batch"
+    return path.find("/workflows") == 0 || path == "/auth/me" || path == "/batch";
 }
 
 } // namespace filters
@@ -0,0 +1,202 @@
+// app/src/filters/RateLimitFilter.cc
+#include "comfyui_plus_backend/filters/RateLimitFilter.h"
+#include "comfyui_plus_backend/models/AuthRequests.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include "comfyui_plus_backend/utils/ReflectJson.h"
+#include <drogon/drogon.h>
+#include <cmath>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace filters
+{
+
+namespace
+{
+
+// Buckets left untouched long enough to refill are dropped this often
+constexpr double kEvictionIntervalSeconds = 60.0;
+
+std::expected<utils::RateLimiter::Limit, std::string> limitFromConfig(const Json::Value &section,
+                                                                      const std::string &name,
+                                                                      utils::RateLimiter::Limit limit)
+{
+    if (section.isNull()) {
+        return limit;
+    }
+    if (!section.isObject()) {
+        return std::unexpected("rate_limits." + name + " must be an object");
+    }
+    if (section.isMember("requests_per_minute")) {
+        const Json::Value &perMinute = section["requests_per_minute"];
+        if (!perMinute.isNumeric() || perMinute.asDouble() <= 0) {
+            return std::unexpected("rate_limits." + name + ".requests_per_minute must be a number above 0");
+        }
+        limit.tokensPerSecond = perMinute.asDouble() / 60.0;
+    }
+    if (section.isMember("burst")) {
+        const Json::Value &burst = section["burst"];
+        if (!burst.isNumeric() || burst.asDouble() < 1) {
+            return std::unexpected("rate_limits." + name + ".burst must be a number of at least 1");
+        }
+        limit.burst = burst.asDouble();
+    }
+    return limit;
+}
+
+drogon::HttpResponsePtr makeTooManyRequests(double retryAfterSeconds)
+{
+    auto resp = drogon::HttpResponse::newHttpJsonResponse({{"error", "Too many requests; try again later."}});
+    resp->setStatusCode(drogon::HttpStatusCode::k429TooManyRequests);
+    resp->addHeader("Retry-After", std::to_string(static_cast<long long>(std::ceil(retryAfterSeconds))));
+    return resp;
+}
+
+// Parses the body the route expects and returns the account it names. The
+// parsed body is kept for the handler; a body that does not parse is left
+// for the handler to reject with its usual 400.
+template <typename Request>
+std::optional<std::string> parseAccount(const drogon::HttpRequestPtr &req)
+{
+    auto body = utils::reflect::fromJson<Request>(req->body());
+    if (!body) {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> account;
+    if constexpr (std::is_same_v<Request, models::LoginRequest>) {
+        account = body->emailOrUsername ? body->emailOrUsername : body->email ? body->email : body->username;
+    } else {
+        account = body->username;
+    }
+    req->attributes()->insert(RateLimitFilter::kParsedBodyAttribute, std::move(*body));
+    return account;
+}
+
+} // namespace
+
+std::expected<RateLimitFilter::Settings, std::string> RateLimitFilter::settingsFromConfig(const Json::Value &section)
+{
+    Settings settings;
+    if (section.isNull()) {
+        return settings;
+    }
+    if (!section.isObject()) {
+        return std::unexpected("rate_limits must be an object");
+    }
+
+    settings.enabled = section.get("enabled", true).asBool();
+    settings.useForwardedFor = section.get("use_forwarded_for", false).asBool();
+    if (section.isMember("max_keys")) {
+        if (!section["max_keys"].isUInt64() || section["max_keys"].asUInt64() == 0) {
+            return std::unexpected("rate_limits.max_keys must be a positive integer");
+        }
+        settings.maxKeys = section["max_keys"].asUInt64();
+    }
+
+    if (section.isMember("exempt_ips")) {
+        const Json::Value &exemptIps = section["exempt_ips"];
+        if (!exemptIps.isArray()) {
+            return std::unexpected("rate_limits.exempt_ips must be an array of addresses");
+        }
+        settings.exemptIps.clear();
+        for (const auto &ip : exemptIps) {
+            if (!ip.isString() || ip.asString().empty()) {
+                return std::unexpected("rate_limits.exempt_ips must be an array of addresses");
+            }
+            settings.exemptIps.insert(ip.asString());
+        }
+    }
+
+    auto perIp = limitFromConfig(section["per_ip"], "per_ip", settings.perIp);
+    if (!perIp) {
+        return std::unexpected(perIp.error());
+    }
+    auto perAccount = limitFromConfig(section["per_account"], "per_account", settings.perAccount);
+    if (!perAccount) {
+        return std::unexpected(perAccount.error());
+    }
+    settings.perIp = *perIp;
+    settings.perAccount = *perAccount;
+    return settings;
+}
+
+RateLimitFilter::RateLimitFilter(const Settings &settings)
+    : settings_(settings),
+      perIp_(std::make_shared<utils::RateLimiter>(settings.perIp, settings.maxKeys)),
+      perAccount_(std::make_shared<utils::RateLimiter>(settings.perAccount, settings.maxKeys))
+{
+    if (settings_.enabled) {
+        drogon::app().getLoop()->runEvery(kEvictionIntervalSeconds, [perIp = perIp_, perAccount = perAccount_]() {
+            const size_t evicted = perIp->evictIdle() + perAccount->evictIdle();
+            LOG_DEBUG << "Rate limiter evicted " << evicted << " idle buckets";
+        });
+    }
+    LOG_DEBUG << "RateLimitFilter instantiated";
+}
+
+std::string RateLimitFilter::clientIp(const drogon::HttpRequestPtr& req) const
+{
+    if (settings_.useForwardedFor) {
+        // The last address is the one our proxy appended; earlier ones are
+        // whatever the client sent
+        std::string_view forwarded = req->getHeader("X-Forwarded-For");
+        size_t comma = forwarded.rfind(',');
+        std::string_view last = comma == std::string_view::npos ? forwarded : forwarded.substr(comma + 1);
+        while (!last.empty() && last.front() == ' ') {
+            last.remove_prefix(1);
+        }
+        while (!last.empty() && last.back() == ' ') {
+            last.remove_suffix(1);
+        }
+        if (!last.empty()) {
+            return std::string(last);
+        }
+    }
+    return req->peerAddr().toIp();
+}
+
+void RateLimitFilter::doFilter(const drogon::HttpRequestPtr& req,
+                               drogon::FilterCallback&& fcb,
+                               drogon::FilterChainCallback&& fccb)
+{
+    if (!settings_.enabled) {
+        fccb();
+        return;
+    }
+
+    const std::string ip = clientIp(req);
+    if (settings_.exemptIps.contains(ip)) {
+        fccb();
+        return;
+    }
+    if (auto decision = perIp_->tryAcquire(ip); !decision.allowed) {
+        utils::Metrics::increment(utils::Metrics::Counter::RateLimitedByIp);
+        LOG_WARN << "Rate limited " << req->getPath() << " from " << ip;
+        fcb(makeTooManyRequests(decision.retryAfterSeconds));
+        return;
+    }
+
+    const std::optional<std::string> account = req->path() == "/auth/register"
+                                                   ? parseAccount<models::RegisterRequest>(req)
+                                                   : parseAccount<models::LoginRequest>(req);
+    if (account) {
+        if (auto decision = perAccount_->tryAcquire(*account); !decision.allowed) {
+            utils::Metrics::increment(utils::Metrics::Counter::RateLimitedByAccount);
+            LOG_WARN << "Rate limited " << req->getPath() << " for account " << *account << " from " << ip;
+            fcb(makeTooManyRequests(decision.retryAfterSeconds));
+            return;
+        }
+    }
+    fccb();
+}
+
+} // namespace filters
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,704 @@
+// app/src/graph/PromptConverter.cc
+#include "comfyui_plus_backend/graph/PromptConverter.h"
+#include <simdjson.h>
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <set>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+namespace
+{
+
+namespace ondemand = simdjson::ondemand;
+
+struct ConverterScratch {
+    ondemand::parser parser;
+    std::string buffer;
+};
+
+ConverterScratch& threadScratch()
+{
+    thread_local ConverterScratch scratch;
+    return scratch;
+}
+
+// See WorkflowIngest: scratch above this is released once smaller bodies follow
+constexpr size_t kRetainedScratchBytes = 8 * 1024 * 1024;
+
+void trimScratch(ConverterScratch& scratch, size_t nextInputSize)
+{
+    if (scratch.buffer.capacity() > kRetainedScratchBytes && nextInputSize < kRetainedScratchBytes) {
+        std::string().swap(scratch.buffer);
+        scratch.parser = ondemand::parser{};
+    }
+}
+
+simdjson::padded_string_view padInto(std::string& buffer, std::string_view input)
+{
+    buffer.reserve(input.size() + simdjson::SIMDJSON_PADDING);
+    buffer.assign(input.data(), input.size());
+    return simdjson::padded_string_view(buffer.data(), buffer.size(), buffer.capacity());
+}
+
+// Node modes as stored by the editor
+constexpr int64_t MODE_NEVER = 2;  // Muted
+constexpr int64_t MODE_BYPASS = 4;
+
+// Editor-only node types that never reach the prompt
+bool isVirtualNode(std::string_view type)
+{
+    return type == "Reroute" || type == "PrimitiveNode" || type == "Note" || type == "MarkdownNote";
+}
+
+bool isWidgetType(std::string_view type)
+{
+    return type == "INT" || type == "FLOAT" || type == "STRING" || type == "BOOLEAN" || type == "COMBO";
+}
+
+// Older editors add the control widget by name rather than from the schema
+bool isLegacySeedWidget(std::string_view name, std::string_view type)
+{
+    return type == "INT" && (name == "seed" || name == "noise_seed");
+}
+
+std::string_view rawJson(ondemand::value value, bool& error)
+{
+    std::string_view raw;
+    error = value.raw_json().get(raw) != simdjson::SUCCESS;
+    // The raw view includes any whitespace that followed the value
+    while (!raw.empty() && (raw.back() == ' ' || raw.back() == '\n' || raw.back() == '\r' ||
+                            raw.back() == '\t')) {
+        raw.remove_suffix(1);
+    }
+    return raw;
+}
+
+std::string keyFromValue(ondemand::value value)
+{
+    int64_t number = 0;
+    if (!value.get_int64().get(number)) {
+        return std::to_string(number);
+    }
+    std::string_view text;
+    if (!value.get_string().get(text)) {
+        return std::string(text);
+    }
+    return {};
+}
+
+void appendJsonString(std::string& out, std::string_view value)
+{
+    out.push_back('"');
+    for (char ch : value) {
+        switch (ch) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                static const char *hex = "0123456789abcdef";
+                out.append("\\u00");
+                out.push_back(hex[(ch >> 4) & 0xF]);
+                out.push_back(hex[ch & 0xF]);
+            } else {
+                out.push_back(ch);
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+struct UiInput {
+    std::string name;
+    std::string type;
+    std::optional<int64_t> link;
+    std::string widgetName; // Set when the input is a widget converted to a socket
+};
+
+struct UiNode {
+    std::string key;
+    std::string type;
+    std::string title;
+    int64_t mode = 0;
+    std::vector<UiInput> inputs;
+    std::vector<std::string> widgetValues;                         // Positional form
+    std::vector<std::pair<std::string, std::string>> namedWidgets; // Object form
+};
+
+struct UiLink {
+    std::string origin;
+    int64_t originSlot = 0;
+    std::string type;
+};
+
+// The value an input resolves to: either a link to a real node or an inlined literal
+struct ResolvedInput {
+    std::string origin;
+    int64_t originSlot = 0;
+    std::string literal;
+    bool isLiteral = false;
+};
+
+class UiWorkflow
+{
+public:
+    std::unordered_map<std::string, size_t> indexByKey;
+    std::vector<UiNode> nodes;
+    std::unordered_map<int64_t, UiLink> links;
+
+    std::optional<ResolvedInput> resolve(int64_t linkId) const
+    {
+        // Bounded walk so a Reroute or bypass loop cannot spin forever
+        for (size_t hops = 0; hops <= nodes.size(); ++hops) {
+            auto linkIt = links.find(linkId);
+            if (linkIt == links.end()) {
+                return std::nullopt;
+            }
+            const UiLink& link = linkIt->second;
+            auto originIt = indexByKey.find(link.origin);
+            if (originIt == indexByKey.end()) {
+                return std::nullopt;
+            }
+            const UiNode& origin = nodes[originIt->second];
+
+            if (origin.type == "PrimitiveNode") {
+                if (origin.widgetValues.empty()) {
+                    return std::nullopt;
+                }
+                ResolvedInput resolved;
+                resolved.literal = origin.widgetValues.front();
+                resolved.isLiteral = true;
+                return resolved;
+            }
+            if (origin.mode == MODE_NEVER) {
+                return std::nullopt;
+            }
+
+            std::optional<int64_t> next;
+            if (origin.type == "Reroute") {
+                if (!origin.inputs.empty()) {
+                    next = origin.inputs.front().link;
+                }
+            } else if (origin.mode == MODE_BYPASS) {
+                // Pass through the input of the same type, preferring the matching slot
+                auto slot = static_cast<size_t>(link.originSlot);
+                if (slot < origin.inputs.size() && origin.inputs[slot].type == link.type &&
+                    origin.inputs[slot].link) {
+                    next = origin.inputs[slot].link;
+                } else {
+                    for (const auto& input : origin.inputs) {
+                        if (input.type == link.type && input.link) {
+                            next = input.link;
+                            break;
+                        }
+                    }
+                }
+            } else {
+                ResolvedInput resolved;
+                resolved.origin = origin.key;
+                resolved.originSlot = link.originSlot;
+                return resolved;
+            }
+
+            if (!next) {
+                return std::nullopt;
+            }
+            linkId = *next;
+        }
+        return std::nullopt;
+    }
+};
+
+std::expected<void, std::string> parseNode(ondemand::object object, UiNode& node)
+{
+    for (auto fieldResult : object) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("json_data.nodes is not valid JSON.");
+        }
+        ondemand::value value = field.value();
+
+        if (key == "id") {
+            node.key = keyFromValue(value);
+        } else if (key == "type") {
+            std::string_view type;
+            if (value.get_string().get(type)) {
+                return std::unexpected("Node type must be a string.");
+            }
+            node.type = type;
+        } else if (key == "title") {
+            std::string_view title;
+            if (!value.get_string().get(title)) {
+                node.title = title;
+            }
+        } else if (key == "mode") {
+            if (value.get_int64().get(node.mode)) {
+                node.mode = 0;
+            }
+        } else if (key == "inputs") {
+            ondemand::array inputs;
+            if (value.get_array().get(inputs)) {
+                continue;
+            }
+            for (auto inputResult : inputs) {
+                ondemand::object inputObject;
+                if (inputResult.get_object().get(inputObject)) {
+                    return std::unexpected("Node inputs must be objects.");
+                }
+                UiInput input;
+                for (auto inputField : inputObject) {
+                    std::string_view inputKey;
+                    if (inputField.unescaped_key().get(inputKey)) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                    ondemand::value inputValue = inputField.value();
+                    std::string_view text;
+                    if (inputKey == "name" && !inputValue.get_string().get(text)) {
+                        input.name = text;
+                    } else if (inputKey == "type" && !inputValue.get_string().get(text)) {
+                        input.type = text;
+                    } else if (inputKey == "link") {
+                        int64_t link = 0;
+                        if (!inputValue.get_int64().get(link)) {
+                            input.link = link;
+                        }
+                    } else if (inputKey == "widget") {
+                        ondemand::object widget;
+                        if (!inputValue.get_object().get(widget) && !widget["name"].get_string().get(text)) {
+                            input.widgetName = text;
+                        }
+                    }
+                }
+                node.inputs.push_back(std::move(input));
+            }
+        } else if (key == "widgets_values") {
+            ondemand::json_type type;
+            if (value.type().get(type)) {
+                return std::unexpected("json_data.nodes is not valid JSON.");
+            }
+            bool error = false;
+            if (type == ondemand::json_type::array) {
+                for (auto element : value.get_array()) {
+                    ondemand::value item;
+                    if (element.get(item)) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                    node.widgetValues.emplace_back(rawJson(item, error));
+                    if (error) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                }
+            } else if (type == ondemand::json_type::object) {
+                for (auto widgetField : value.get_object()) {
+                    std::string_view widgetKey;
+                    if (widgetField.unescaped_key().get(widgetKey)) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                    std::string name(widgetKey);
+                    node.namedWidgets.emplace_back(std::move(name), rawJson(widgetField.value(), error));
+                    if (error) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                }
+            }
+        }
+        // Positions, sizes, colours, outputs and properties are layout only
+    }
+
+    if (node.key.empty() || node.type.empty()) {
+        return std::unexpected("Every node in json_data.nodes needs an id and a type.");
+    }
+    return {};
+}
+
+std::expected<void, std::string> parseLink(ondemand::value value, UiWorkflow& workflow)
+{
+    ondemand::json_type type;
+    if (value.type().get(type)) {
+        return std::unexpected("json_data.links is not valid JSON.");
+    }
+
+    std::optional<int64_t> linkId;
+    UiLink link;
+    if (type == ondemand::json_type::array) {
+        // [link_id, origin_id, origin_slot, target_id, target_slot, type]
+        size_t position = 0;
+        for (auto element : value.get_array()) {
+            ondemand::value item;
+            if (element.get(item)) {
+                return std::unexpected("json_data.links is not valid JSON.");
+            }
+            int64_t number = 0;
+            std::string_view text;
+            if (position == 0 && !item.get_int64().get(number)) {
+                linkId = number;
+            } else if (position == 1) {
+                link.origin = keyFromValue(item);
+            } else if (position == 2 && !item.get_int64().get(number)) {
+                link.originSlot = number;
+            } else if (position == 5 && !item.get_string().get(text)) {
+                link.type = text;
+            }
+            ++position;
+        }
+    } else if (type == ondemand::json_type::object) {
+        for (auto linkField : value.get_object()) {
+            std::string_view key;
+            if (linkField.unescaped_key().get(key)) {
+                return std::unexpected("json_data.links is not valid JSON.");
+            }
+            ondemand::value item = linkField.value();
+            int64_t number = 0;
+            std::string_view text;
+            if (key == "id" && !item.get_int64().get(number)) {
+                linkId = number;
+            } else if (key == "origin_id") {
+                link.origin = keyFromValue(item);
+            } else if (key == "origin_slot" && !item.get_int64().get(number)) {
+                link.originSlot = number;
+            } else if (key == "type" && !item.get_string().get(text)) {
+                link.type = text;
+            }
+        }
+    } else {
+        return std::unexpected("Every entry in json_data.links must be an array or object.");
+    }
+
+    if (linkId) {
+        workflow.links.insert_or_assign(*linkId, std::move(link));
+    }
+    return {};
+}
+
+// Maps a node's widget values to input names, appending "name":value pairs
+// to inputs. Returns false when no layout is known for the node's type.
+bool collectWidgets(const UiNode& node, const NodeSchemaRegistry& schemas,
+                    std::vector<std::pair<std::string, std::string>>& inputs)
+{
+    if (!node.namedWidgets.empty()) {
+        inputs = node.namedWidgets;
+        return true;
+    }
+    if (node.widgetValues.empty()) {
+        return true;
+    }
+
+    std::vector<NodeSchema::Widget> fallback;
+    const NodeSchema* schema = schemas.find(node.type);
+    if (!schema) {
+        // Newer editors list every widget among the node's inputs; use that order
+        for (const auto& input : node.inputs) {
+            if (!input.widgetName.empty()) {
+                fallback.push_back({input.widgetName, isLegacySeedWidget(input.widgetName, input.type)});
+            }
+        }
+        if (fallback.empty()) {
+            return false;
+        }
+    }
+    const auto& widgets = schema ? schema->widgets : fallback;
+
+    size_t position = 0;
+    for (const auto& widget : widgets) {
+        if (position >= node.widgetValues.size()) {
+            break;
+        }
+        inputs.emplace_back(widget.name, node.widgetValues[position++]);
+        if (widget.controlAfterGenerate) {
+            ++position;
+        }
+    }
+    return true;
+}
+
+std::expected<std::string, std::string> convertUiWorkflow(const UiWorkflow& workflow,
+                                                          const NodeSchemaRegistry& schemas,
+                                                          size_t sizeHint)
+{
+    std::string out;
+    out.reserve(sizeHint / 2);
+    out.push_back('{');
+
+    std::set<std::string> unknownTypes;
+    bool firstNode = true;
+    std::vector<std::pair<std::string, std::string>> inputs;
+
+    for (const auto& node : workflow.nodes) {
+        if (node.mode == MODE_NEVER || node.mode == MODE_BYPASS || isVirtualNode(node.type)) {
+            continue;
+        }
+
+        inputs.clear();
+        if (!collectWidgets(node, schemas, inputs)) {
+            unknownTypes.insert(node.type);
+            continue;
+        }
+
+        // Links override widget values of the same name (widgets converted to sockets)
+        for (const auto& input : node.inputs) {
+            if (!input.link) {
+                continue;
+            }
+            auto resolved = workflow.resolve(*input.link);
+            if (!resolved) {
+                continue;
+            }
+            std::string value;
+            if (resolved->isLiteral) {
+                value = std::move(resolved->literal);
+            } else {
+                appendJsonString(value, resolved->origin);
+                value = "[" + value + "," + std::to_string(resolved->originSlot) + "]";
+            }
+            const std::string& name = input.widgetName.empty() ? input.name : input.widgetName;
+            auto existing = std::find_if(inputs.begin(), inputs.end(),
+                                         [&](const auto& entry) { return entry.first == name; });
+            if (existing != inputs.end()) {
+                existing->second = std::move(value);
+            } else {
+                inputs.emplace_back(name, std::move(value));
+            }
+        }
+
+        if (!firstNode) {
+            out.push_back(',');
+        }
+        firstNode = false;
+
+        appendJsonString(out, node.key);
+        out.append(":{\"inputs\":{");
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (i > 0) {
+                out.push_back(',');
+            }
+            appendJsonString(out, inputs[i].first);
+            out.push_back(':');
+            out.append(inputs[i].second);
+        }
+        out.append("},\"class_type\":");
+        appendJsonString(out, node.type);
+        out.append(",\"_meta\":{\"title\":");
+        appendJsonString(out, node.title.empty() ? node.type : node.title);
+        out.append("}}");
+    }
+    out.push_back('}');
+
+    if (!unknownTypes.empty()) {
+        std::string message = "No widget schema for node types:";
+        for (const auto& type : unknownTypes) {
+            message += ' ' + type;
+        }
+        return std::unexpected(message + ". Configure comfyui.object_info_path.");
+    }
+    return out;
+}
+
+} // namespace
+
+std::expected<NodeSchemaRegistry, std::string> NodeSchemaRegistry::fromObjectInfo(std::string_view json)
+{
+    auto& scratch = threadScratch();
+    trimScratch(scratch, json.size());
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.parser.iterate(padInto(scratch.buffer, json)).get(doc) || doc.get_object().get(root)) {
+        return std::unexpected("object_info must be a JSON object.");
+    }
+
+    NodeSchemaRegistry registry;
+    for (auto nodeResult : root) {
+        ondemand::field nodeField;
+        std::string_view classType;
+        ondemand::object definition;
+        if (std::move(nodeResult).get(nodeField) || nodeField.unescaped_key().get(classType) ||
+            nodeField.value().get_object().get(definition)) {
+            return std::unexpected("object_info is not valid JSON.");
+        }
+        std::string classTypeName(classType);
+
+        ondemand::object input;
+        if (definition["input"].get_object().get(input)) {
+            registry.schemas_.emplace(std::move(classTypeName), NodeSchema{});
+            continue;
+        }
+
+        NodeSchema schema;
+        for (auto sectionResult : input) {
+            std::string_view section;
+            ondemand::object specs;
+            if (sectionResult.unescaped_key().get(section)) {
+                return std::unexpected("object_info is not valid JSON.");
+            }
+            if ((section != "required" && section != "optional") ||
+                sectionResult.value().get_object().get(specs)) {
+                continue; // "hidden" inputs are injected by the server
+            }
+
+            for (auto specResult : specs) {
+                std::string_view inputName;
+                ondemand::array spec;
+                if (specResult.unescaped_key().get(inputName) || specResult.value().get_array().get(spec)) {
+                    continue;
+                }
+                std::string name(inputName);
+
+                // [type or combo option list, {options}]
+                bool isWidget = false;
+                bool forceInput = false;
+                bool controlAfterGenerate = false;
+                std::string typeName;
+                size_t position = 0;
+                for (auto element : spec) {
+                    ondemand::value item;
+                    if (element.get(item)) {
+                        break;
+                    }
+                    if (position == 0) {
+                        ondemand::json_type type;
+                        std::string_view text;
+                        if (!item.type().get(type) && type == ondemand::json_type::array) {
+                            isWidget = true;
+                        } else if (!item.get_string().get(text)) {
+                            typeName = text;
+                            isWidget = isWidgetType(text);
+                        }
+                    } else if (position == 1) {
+                        ondemand::object options;
+                        if (!item.get_object().get(options)) {
+                            for (auto option : options) {
+                                std::string_view optionKey;
+                                bool flag = false;
+                                if (option.unescaped_key().get(optionKey)) {
+                                    break;
+                                }
+                                if (optionKey == "forceInput" && !option.value().get_bool().get(flag)) {
+                                    forceInput = flag;
+                                } else if (optionKey == "control_after_generate" &&
+                                           !option.value().get_bool().get(flag)) {
+                                    controlAfterGenerate = flag;
+                                }
+                            }
+                        }
+                    }
+                    ++position;
+                }
+
+                if (isWidget && !forceInput) {
+                    controlAfterGenerate = controlAfterGenerate || isLegacySeedWidget(name, typeName);
+                    schema.widgets.push_back({std::move(name), controlAfterGenerate});
+                }
+            }
+        }
+        registry.schemas_.insert_or_assign(std::move(classTypeName), std::move(schema));
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("object_info has trailing content.");
+    }
+    return registry;
+}
+
+std::expected<NodeSchemaRegistry, std::string> NodeSchemaRegistry::loadFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return std::unexpected("Cannot open " + path);
+    }
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return fromObjectInfo(contents);
+}
+
+const NodeSchema* NodeSchemaRegistry::find(std::string_view classType) const
+{
+    auto it = schemas_.find(classType);
+    return it == schemas_.end() ? nullptr : &it->second;
+}
+
+std::expected<std::string, std::string> PromptConverter::convert(std::string_view jsonData) const
+{
+    auto& scratch = threadScratch();
+    trimScratch(scratch, jsonData.size());
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.parser.iterate(padInto(scratch.buffer, jsonData)).get(doc) || doc.get_object().get(root)) {
+        return std::unexpected("json_data must be a JSON object.");
+    }
+
+    UiWorkflow workflow;
+    bool uiFormat = false;
+    bool apiFormat = false;
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+        ondemand::value value = field.value();
+        ondemand::json_type type;
+        if (value.type().get(type)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+
+        if (key == "nodes" && type == ondemand::json_type::array) {
+            uiFormat = true;
+            for (auto nodeResult : value.get_array()) {
+                ondemand::object object;
+                if (nodeResult.get_object().get(object)) {
+                    return std::unexpected("Every entry in json_data.nodes must be an object.");
+                }
+                UiNode node;
+                auto parsed = parseNode(object, node);
+                if (!parsed) {
+                    return std::unexpected(parsed.error());
+                }
+                if (!workflow.indexByKey.emplace(node.key, workflow.nodes.size()).second) {
+                    return std::unexpected("Duplicate node id " + node.key + " in json_data.");
+                }
+                workflow.nodes.push_back(std::move(node));
+            }
+        } else if (key == "links" && type == ondemand::json_type::array) {
+            for (auto linkResult : value.get_array()) {
+                ondemand::value link;
+                if (linkResult.get(link)) {
+                    return std::unexpected("json_data.links is not valid JSON.");
+                }
+                auto parsed = parseLink(link, workflow);
+                if (!parsed) {
+                    return std::unexpected(parsed.error());
+                }
+            }
+        } else if (!uiFormat && !apiFormat && type == ondemand::json_type::object) {
+            ondemand::object node;
+            std::string_view classType;
+            apiFormat = !value.get_object().get(node) &&
+                        !node.find_field_unordered("class_type").get_string().get(classType);
+        }
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("json_data has trailing content.");
+    }
+
+    if (!uiFormat) {
+        if (apiFormat) {
+            return std::string(jsonData);
+        }
+        return std::unexpected("json_data is neither an editor workflow nor an API prompt.");
+    }
+    return convertUiWorkflow(workflow, schemas_, jsonData.size());
+}
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
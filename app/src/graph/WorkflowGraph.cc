@@ -0,0 +1,372 @@
+// app/src/graph/WorkflowGraph.cc
+#include "comfyui_plus_backend/graph/WorkflowGraph.h"
+#include <simdjson.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+namespace
+{
+
+namespace ondemand = simdjson::ondemand;
+
+struct GraphScratch {
+    ondemand::parser parser;
+    std::string buffer;
+};
+
+GraphScratch& threadScratch()
+{
+    thread_local GraphScratch scratch;
+    return scratch;
+}
+
+// See WorkflowIngest: scratch above this is released once smaller bodies follow
+constexpr size_t kRetainedScratchBytes = 8 * 1024 * 1024;
+
+void trimScratch(GraphScratch& scratch, size_t nextInputSize)
+{
+    if (scratch.buffer.capacity() > kRetainedScratchBytes && nextInputSize < kRetainedScratchBytes) {
+        std::string().swap(scratch.buffer);
+        scratch.parser = ondemand::parser{};
+    }
+}
+
+struct TransparentStringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+};
+
+// A link as written in the document, before node ids are resolved to indices
+struct RawLink {
+    int64_t linkId;
+    std::string origin;
+    std::string target;
+};
+
+std::string keyFromValue(ondemand::value value)
+{
+    int64_t number = 0;
+    if (!value.get_int64().get(number)) {
+        return std::to_string(number);
+    }
+    std::string_view text;
+    if (!value.get_string().get(text)) {
+        return std::string(text);
+    }
+    return {};
+}
+
+} // namespace
+
+/**
+ * @brief Accumulates nodes and raw links during a parse, then lays out the CSR arrays
+ */
+class GraphBuilder
+{
+public:
+    std::expected<void, std::string> addNode(std::string key, std::string_view type)
+    {
+        auto [it, inserted] = indexByKey_.try_emplace(key, static_cast<uint32_t>(graph_.nodeKeys_.size()));
+        if (!inserted) {
+            return std::unexpected("Duplicate node id " + key + " in json_data.");
+        }
+
+        // Each distinct type gets the next id of this graph
+        auto typeIt = localTypes_.find(type);
+        if (typeIt == localTypes_.end()) {
+            typeIt = localTypes_.emplace(type, static_cast<uint32_t>(graph_.typeNames_.size())).first;
+            graph_.typeNames_.emplace_back(type);
+        }
+
+        graph_.nodeKeys_.push_back(std::move(key));
+        graph_.nodeTypes_.push_back(typeIt->second);
+        return {};
+    }
+
+    void addLink(int64_t linkId, std::string origin, std::string target)
+    {
+        rawLinks_.push_back({linkId, std::move(origin), std::move(target)});
+    }
+
+    WorkflowGraph finish()
+    {
+        const size_t nodeCount = graph_.nodeKeys_.size();
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        edges.reserve(rawLinks_.size());
+
+        for (auto& link : rawLinks_) {
+            auto origin = indexByKey_.find(link.origin);
+            auto target = indexByKey_.find(link.target);
+            if (origin == indexByKey_.end() || target == indexByKey_.end()) {
+                DanglingLink dangling;
+                dangling.linkId = link.linkId;
+                dangling.missingOrigin = origin == indexByKey_.end();
+                dangling.missingTarget = target == indexByKey_.end();
+                dangling.originNode = std::move(link.origin);
+                dangling.targetNode = std::move(link.target);
+                graph_.danglingLinks_.push_back(std::move(dangling));
+                continue;
+            }
+            edges.emplace_back(origin->second, target->second);
+        }
+
+        // Counting sort of edges by origin into CSR form
+        graph_.offsets_.assign(nodeCount + 1, 0);
+        for (const auto& [origin, target] : edges) {
+            ++graph_.offsets_[origin + 1];
+        }
+        for (size_t i = 0; i < nodeCount; ++i) {
+            graph_.offsets_[i + 1] += graph_.offsets_[i];
+        }
+        graph_.targets_.resize(edges.size());
+        std::vector<uint32_t> cursor(graph_.offsets_.begin(), graph_.offsets_.end() - 1);
+        for (const auto& [origin, target] : edges) {
+            graph_.targets_[cursor[origin]++] = target;
+        }
+
+        return std::move(graph_);
+    }
+
+private:
+    WorkflowGraph graph_;
+    std::unordered_map<std::string, uint32_t> indexByKey_;
+    std::unordered_map<std::string, uint32_t, TransparentStringHash, std::equal_to<>> localTypes_;
+    std::vector<RawLink> rawLinks_;
+};
+
+std::expected<WorkflowGraph, std::string> WorkflowGraph::parse(std::string_view jsonData)
+{
+    auto& scratch = threadScratch();
+    trimScratch(scratch, jsonData.size());
+    scratch.buffer.reserve(jsonData.size() + simdjson::SIMDJSON_PADDING);
+    scratch.buffer.assign(jsonData.data(), jsonData.size());
+    simdjson::padded_string_view padded(scratch.buffer.data(), scratch.buffer.size(),
+                                        scratch.buffer.capacity());
+
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.parser.iterate(padded).get(doc) || doc.get_object().get(root)) {
+        return std::unexpected("json_data must be a JSON object.");
+    }
+
+    GraphBuilder builder;
+    bool uiFormat = false;
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+        ondemand::value value = field.value();
+        ondemand::json_type type;
+        if (value.type().get(type)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+
+        if (key == "nodes" && type == ondemand::json_type::array) {
+            uiFormat = true;
+            for (auto nodeResult : value.get_array()) {
+                ondemand::object node;
+                int64_t id = 0;
+                std::string_view nodeType;
+                if (nodeResult.get_object().get(node) || node["id"].get_int64().get(id) ||
+                    node["type"].get_string().get(nodeType)) {
+                    return std::unexpected("Every node in json_data.nodes needs an integer id and a string type.");
+                }
+                auto added = builder.addNode(std::to_string(id), nodeType);
+                if (!added) {
+                    return std::unexpected(added.error());
+                }
+            }
+        } else if (key == "links" && type == ondemand::json_type::array) {
+            for (auto linkResult : value.get_array()) {
+                ondemand::value link;
+                ondemand::json_type linkType;
+                if (linkResult.get(link) || link.type().get(linkType)) {
+                    return std::unexpected("json_data.links is not valid JSON.");
+                }
+
+                int64_t linkId = -1;
+                std::string origin;
+                std::string target;
+                if (linkType == ondemand::json_type::array) {
+                    // [link_id, origin_id, origin_slot, target_id, target_slot, type]
+                    size_t position = 0;
+                    for (auto element : link.get_array()) {
+                        ondemand::value item;
+                        if (element.get(item)) {
+                            return std::unexpected("json_data.links is not valid JSON.");
+                        }
+                        if (position == 0) {
+                            if (item.get_int64().get(linkId)) {
+                                linkId = -1;
+                            }
+                        } else if (position == 1) {
+                            origin = keyFromValue(item);
+                        } else if (position == 3) {
+                            target = keyFromValue(item);
+                        }
+                        ++position;
+                    }
+                } else if (linkType == ondemand::json_type::object) {
+                    // {"id", "origin_id", "origin_slot", "target_id", "target_slot", "type"}
+                    for (auto linkField : link.get_object()) {
+                        std::string_view linkKey;
+                        if (linkField.unescaped_key().get(linkKey)) {
+                            return std::unexpected("json_data.links is not valid JSON.");
+                        }
+                        if (linkKey == "id") {
+                            if (linkField.value().get_int64().get(linkId)) {
+                                linkId = -1;
+                            }
+                        } else if (linkKey == "origin_id") {
+                            origin = keyFromValue(linkField.value());
+                        } else if (linkKey == "target_id") {
+                            target = keyFromValue(linkField.value());
+                        }
+                    }
+                } else {
+                    return std::unexpected("Every entry in json_data.links must be an array or object.");
+                }
+                builder.addLink(linkId, std::move(origin), std::move(target));
+            }
+        } else if (!uiFormat && type == ondemand::json_type::object) {
+            // API prompt format: {"<id>": {"class_type": ..., "inputs": {"x": ["<source id>", slot]}}}
+            std::string nodeKey(key);
+            std::string classType;
+            std::vector<std::string> sources;
+            for (auto nodeField : value.get_object()) {
+                std::string_view nodeFieldKey;
+                if (nodeField.unescaped_key().get(nodeFieldKey)) {
+                    return std::unexpected("json_data is not valid JSON.");
+                }
+                if (nodeFieldKey == "class_type") {
+                    std::string_view classTypeView;
+                    if (!nodeField.value().get_string().get(classTypeView)) {
+                        classType = classTypeView;
+                    }
+                } else if (nodeFieldKey == "inputs") {
+                    ondemand::object inputs;
+                    if (nodeField.value().get_object().get(inputs)) {
+                        continue;
+                    }
+                    for (auto input : inputs) {
+                        ondemand::array reference;
+                        if (input.value().get_array().get(reference)) {
+                            continue; // Widget value, not a link
+                        }
+                        size_t position = 0;
+                        std::string source;
+                        bool slotIsNumber = false;
+                        for (auto element : reference) {
+                            ondemand::value item;
+                            if (element.get(item)) {
+                                break;
+                            }
+                            if (position == 0) {
+                                source = keyFromValue(item);
+                            } else if (position == 1) {
+                                int64_t slot = 0;
+                                slotIsNumber = !item.get_int64().get(slot);
+                            }
+                            ++position;
+                        }
+                        if (position == 2 && slotIsNumber && !source.empty()) {
+                            sources.push_back(std::move(source));
+                        }
+                    }
+                }
+            }
+            if (classType.empty()) {
+                continue; // Not a node
+            }
+            auto added = builder.addNode(nodeKey, classType);
+            if (!added) {
+                return std::unexpected(added.error());
+            }
+            for (auto& source : sources) {
+                builder.addLink(-1, std::move(source), nodeKey);
+            }
+        }
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("json_data has trailing content.");
+    }
+
+    return builder.finish();
+}
+
+GraphAnalysis analyzeGraph(const WorkflowGraph& graph)
+{
+    const auto nodeCount = static_cast<uint32_t>(graph.nodeCount());
+
+    GraphAnalysis analysis;
+    analysis.nodeCount = nodeCount;
+    analysis.linkCount = graph.edgeCount() + graph.danglingLinks().size();
+    analysis.danglingLinks = graph.danglingLinks();
+
+    // Kahn's algorithm; the order vector doubles as the work queue
+    std::vector<uint32_t> inDegree(nodeCount, 0);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        for (uint32_t successor : graph.successors(node)) {
+            ++inDegree[successor];
+        }
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(nodeCount);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        if (inDegree[node] == 0) {
+            order.push_back(node);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (uint32_t successor : graph.successors(order[head])) {
+            if (--inDegree[successor] == 0) {
+                order.push_back(successor);
+            }
+        }
+    }
+
+    analysis.topologicalOrder.reserve(order.size());
+    for (uint32_t node : order) {
+        analysis.topologicalOrder.push_back(graph.nodeKey(node));
+    }
+
+    analysis.hasCycle = order.size() < nodeCount;
+    if (analysis.hasCycle) {
+        for (uint32_t node = 0; node < nodeCount; ++node) {
+            if (inDegree[node] > 0) {
+                analysis.cycleNodes.push_back(graph.nodeKey(node));
+            }
+        }
+    }
+
+    // Per-type counts; type ids are dense, so a plain array indexed by id
+    std::vector<size_t> counts(graph.typeCount(), 0);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        ++counts[graph.nodeType(node)];
+    }
+    for (uint32_t type = 0; type < counts.size(); ++type) {
+        if (counts[type] > 0) {
+            analysis.typeCounts.emplace_back(graph.typeName(type), counts[type]);
+        }
+    }
+    std::stable_sort(analysis.typeCounts.begin(), analysis.typeCounts.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    return analysis;
+}
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,343 @@
+// app/src/graph/WorkflowLayout.cc
+#include "comfyui_plus_backend/graph/WorkflowLayout.h"
+#include <simdjson.h>
+#include <unordered_map>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace graph
+{
+
+namespace
+{
+
+namespace ondemand = simdjson::ondemand;
+
+// Merging reads the layout and the graph at the same time, hence two parsers
+struct LayoutScratch {
+    ondemand::parser graphParser;
+    ondemand::parser layoutParser;
+    std::string graphBuffer;
+    std::string layoutBuffer;
+};
+
+LayoutScratch& threadScratch()
+{
+    thread_local LayoutScratch scratch;
+    return scratch;
+}
+
+// See WorkflowIngest: scratch above this is released once smaller bodies follow
+constexpr size_t kRetainedScratchBytes = 8 * 1024 * 1024;
+
+void trimScratch(LayoutScratch& scratch, size_t nextInputSize)
+{
+    if (nextInputSize >= kRetainedScratchBytes) {
+        return;
+    }
+    if (scratch.graphBuffer.capacity() > kRetainedScratchBytes) {
+        std::string().swap(scratch.graphBuffer);
+        scratch.graphParser = ondemand::parser{};
+    }
+    if (scratch.layoutBuffer.capacity() > kRetainedScratchBytes) {
+        std::string().swap(scratch.layoutBuffer);
+        scratch.layoutParser = ondemand::parser{};
+    }
+}
+
+simdjson::padded_string_view padInto(std::string& buffer, std::string_view input)
+{
+    buffer.reserve(input.size() + simdjson::SIMDJSON_PADDING);
+    buffer.assign(input.data(), input.size());
+    return simdjson::padded_string_view(buffer.data(), buffer.size(), buffer.capacity());
+}
+
+// Node fields only the editor reads
+bool isNodeLayoutKey(std::string_view key)
+{
+    return key == "pos" || key == "size" || key == "flags" || key == "order" || key == "color" ||
+           key == "bgcolor" || key == "shape";
+}
+
+// Top-level fields only the editor reads; `extra` carries the `ds` viewport
+bool isTopLevelLayoutKey(std::string_view key)
+{
+    return key == "groups" || key == "extra";
+}
+
+std::expected<std::string_view, std::string> rawJson(ondemand::value value)
+{
+    std::string_view raw;
+    if (value.raw_json().get(raw)) {
+        return std::unexpected("json_data is not valid JSON.");
+    }
+    // The raw view includes any whitespace that followed the value
+    while (!raw.empty() && (raw.back() == ' ' || raw.back() == '\n' || raw.back() == '\r' ||
+                            raw.back() == '\t')) {
+        raw.remove_suffix(1);
+    }
+    return raw;
+}
+
+// Appends `"key":raw`, preceded by a comma unless out ends an opening bracket
+void appendMember(std::string& out, std::string_view escapedKey, std::string_view raw)
+{
+    if (out.back() != '{' && out.back() != '[') {
+        out.push_back(',');
+    }
+    out.push_back('"');
+    out.append(escapedKey);
+    out.append("\":");
+    out.append(raw);
+}
+
+// Node ids are numbers in editor exports, but strings are tolerated
+std::string_view idKey(std::string_view rawId)
+{
+    if (rawId.size() >= 2 && rawId.front() == '"' && rawId.back() == '"') {
+        return rawId.substr(1, rawId.size() - 2);
+    }
+    return rawId;
+}
+
+} // namespace
+
+std::expected<WorkflowParts, std::string> splitLayout(std::string_view jsonData, size_t capacity)
+{
+    auto& scratch = threadScratch();
+    trimScratch(scratch, jsonData.size());
+    auto padded = capacity >= jsonData.size() + simdjson::SIMDJSON_PADDING
+                      ? simdjson::padded_string_view(jsonData.data(), jsonData.size(), capacity)
+                      : padInto(scratch.graphBuffer, jsonData);
+
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.graphParser.iterate(padded).get(doc) ||
+        doc.get_object().get(root)) {
+        return std::unexpected("json_data must be a JSON object.");
+    }
+
+    WorkflowParts parts;
+    parts.graph.reserve(jsonData.size());
+    parts.graph.push_back('{');
+    std::string layoutNodes = "{";
+    std::string layoutTop;
+    bool uiFormat = false;
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        if (std::move(fieldResult).get(field)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+        std::string_view key = field.escaped_key();
+        ondemand::value value = field.value();
+
+        ondemand::array nodes;
+        if (key == "nodes" && !value.get_array().get(nodes)) {
+            uiFormat = true;
+            appendMember(parts.graph, key, "[");
+            for (auto nodeResult : nodes) {
+                ondemand::object node;
+                if (nodeResult.get_object().get(node)) {
+                    return std::unexpected("Every entry in json_data.nodes must be an object.");
+                }
+                if (parts.graph.back() != '[') {
+                    parts.graph.push_back(',');
+                }
+                parts.graph.push_back('{');
+
+                std::string_view nodeId;
+                std::string nodeLayout = "{";
+                for (auto nodeFieldResult : node) {
+                    ondemand::field nodeField;
+                    if (std::move(nodeFieldResult).get(nodeField)) {
+                        return std::unexpected("json_data.nodes is not valid JSON.");
+                    }
+                    std::string_view nodeKey = nodeField.escaped_key();
+                    auto raw = rawJson(nodeField.value());
+                    if (!raw) {
+                        return std::unexpected(raw.error());
+                    }
+                    if (isNodeLayoutKey(nodeKey)) {
+                        appendMember(nodeLayout, nodeKey, *raw);
+                    } else {
+                        if (nodeKey == "id") {
+                            nodeId = idKey(*raw);
+                        }
+                        appendMember(parts.graph, nodeKey, *raw);
+                    }
+                }
+                parts.graph.push_back('}');
+
+                if (nodeLayout.size() > 1 && !nodeId.empty()) {
+                    nodeLayout.push_back('}');
+                    appendMember(layoutNodes, nodeId, nodeLayout);
+                }
+            }
+            parts.graph.push_back(']');
+            continue;
+        }
+
+        auto raw = rawJson(value);
+        if (!raw) {
+            return std::unexpected(raw.error());
+        }
+        if (isTopLevelLayoutKey(key)) {
+            layoutTop.append(",\"").append(key).append("\":").append(*raw);
+        } else {
+            appendMember(parts.graph, key, *raw);
+        }
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("json_data has trailing content.");
+    }
+
+    // API prompts carry no layout; keep the body exactly as sent
+    if (!uiFormat) {
+        parts.graph.assign(jsonData.data(), jsonData.size());
+        return parts;
+    }
+
+    parts.graph.push_back('}');
+    layoutNodes.push_back('}');
+    parts.layout.reserve(layoutNodes.size() + layoutTop.size() + 16);
+    parts.layout.append("{\"nodes\":").append(layoutNodes).append(layoutTop).push_back('}');
+    return parts;
+}
+
+std::expected<std::string, std::string> mergeLayout(std::string_view graph, std::string_view layout)
+{
+    if (layout.empty()) {
+        return std::string(graph);
+    }
+
+    auto& scratch = threadScratch();
+    trimScratch(scratch, graph.size() + layout.size());
+
+    // Index the layout first: node id -> members of its layout object
+    std::unordered_map<std::string_view, std::string_view> nodeLayouts;
+    std::string layoutTop;
+    {
+        ondemand::document doc;
+        ondemand::object root;
+        if (scratch.layoutParser.iterate(padInto(scratch.layoutBuffer, layout)).get(doc) ||
+            doc.get_object().get(root)) {
+            return std::unexpected("Stored layout is not a JSON object.");
+        }
+        for (auto fieldResult : root) {
+            ondemand::field field;
+            if (std::move(fieldResult).get(field)) {
+                return std::unexpected("Stored layout is not valid JSON.");
+            }
+            std::string_view key = field.escaped_key();
+            ondemand::object nodes;
+            if (key == "nodes" && !field.value().get_object().get(nodes)) {
+                for (auto nodeResult : nodes) {
+                    ondemand::field nodeField;
+                    if (std::move(nodeResult).get(nodeField)) {
+                        return std::unexpected("Stored layout is not valid JSON.");
+                    }
+                    std::string_view nodeId = nodeField.escaped_key();
+                    auto raw = rawJson(nodeField.value());
+                    if (!raw || raw->size() < 2) {
+                        return std::unexpected("Stored layout is not valid JSON.");
+                    }
+                    nodeLayouts.emplace(nodeId, raw->substr(1, raw->size() - 2)); // Strip the braces
+                }
+                continue;
+            }
+            auto raw = rawJson(field.value());
+            if (!raw) {
+                return std::unexpected("Stored layout is not valid JSON.");
+            }
+            layoutTop.append(",\"").append(key).append("\":").append(*raw);
+        }
+    }
+
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.graphParser.iterate(padInto(scratch.graphBuffer, graph)).get(doc) ||
+        doc.get_object().get(root)) {
+        return std::unexpected("Stored graph is not a JSON object.");
+    }
+
+    std::string out;
+    out.reserve(graph.size() + layout.size() + 16);
+    out.push_back('{');
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        if (std::move(fieldResult).get(field)) {
+            return std::unexpected("Stored graph is not valid JSON.");
+        }
+        std::string_view key = field.escaped_key();
+        ondemand::value value = field.value();
+
+        ondemand::array nodes;
+        if (key == "nodes" && !value.get_array().get(nodes)) {
+            appendMember(out, key, "[");
+            for (auto nodeResult : nodes) {
+                ondemand::object node;
+                if (nodeResult.get_object().get(node)) {
+                    return std::unexpected("Stored graph is not valid JSON.");
+                }
+                if (out.back() != '[') {
+                    out.push_back(',');
+                }
+                out.push_back('{');
+
+                std::string_view nodeId;
+                for (auto nodeFieldResult : node) {
+                    ondemand::field nodeField;
+                    if (std::move(nodeFieldResult).get(nodeField)) {
+                        return std::unexpected("Stored graph is not valid JSON.");
+                    }
+                    std::string_view nodeKey = nodeField.escaped_key();
+                    auto raw = rawJson(nodeField.value());
+                    if (!raw) {
+                        return std::unexpected("Stored graph is not valid JSON.");
+                    }
+                    if (nodeKey == "id") {
+                        nodeId = idKey(*raw);
+                    }
+                    appendMember(out, nodeKey, *raw);
+                }
+
+                auto nodeLayout = nodeLayouts.find(nodeId);
+                if (nodeLayout != nodeLayouts.end() && !nodeLayout->second.empty()) {
+                    if (out.back() != '{') {
+                        out.push_back(',');
+                    }
+                    out.append(nodeLayout->second);
+                }
+                out.push_back('}');
+            }
+            out.push_back(']');
+            continue;
+        }
+
+        auto raw = rawJson(value);
+        if (!raw) {
+            return std::unexpected("Stored graph is not valid JSON.");
+        }
+        appendMember(out, key, *raw);
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("Stored graph has trailing content.");
+    }
+
+    if (out.size() == 1 && !layoutTop.empty()) {
+        layoutTop.erase(0, 1); // No graph members precede the layout ones
+    }
+    out.append(layoutTop);
+    out.push_back('}');
+    return out;
+}
+
+} // namespace graph
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -1,6 +1,5 @@
 // app/src/models/User.cc
 #include "comfyui_plus_backend/models/User.h"
-#include "comfyui_plus_backend/utils/DateTimeUtils.h"
 #include <string>
 
 namespace comfyui_plus_backend {
@@ -16,17 +15,15 @@ User User::fromRow(const ::drogon::orm::Row &row) {
     user.email_ = row["email"].as<std::string>();
     user.hashedPassword_ = row["hashed_password"].as<std::string>();
     
-    // Handle date conversion using the utility class
+    // Timestamps are stored as epoch microseconds
     if (!row["created_at"].isNull()) {
-        std::string dateStr = row["created_at"].as<std::string>();
-        user.createdAt_ = utils::DateTimeUtils::dbStringToDate(dateStr);
+        user.createdAt_ = trantor::Date(row["created_at"].as<int64_t>());
     } else {
         user.createdAt_ = trantor::Date::now();
     }
     
     if (!row["updated_at"].isNull()) {
-        std::string dateStr = row["updated_at"].as<std::string>();
-        user.updatedAt_ = utils::DateTimeUtils::dbStringToDate(dateStr);
+        user.updatedAt_ = trantor::Date(row["updated_at"].as<int64_t>());
     } else {
         user.updatedAt_ = trantor::Date::now();
     }
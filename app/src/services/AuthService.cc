@@ -1,4 +1,5 @@
 #include "comfyui_plus_backend/services/AuthService.h"
+#include "comfyui_plus_backend/utils/Log.h"
 #include "comfyui_plus_backend/utils/PasswordUtils.h" // For password verification
 #include <drogon/drogon.h> // For LOG_WARN, LOG_ERROR
 #include <source_location> // For better error reporting
@@ -34,16 +35,15 @@ AuthService::registerUser(
         return std::unexpected(AuthError("Password must be at least 8 characters long.", 400));
     }
 
-    // Check if user already exists (username or email)
-    if (userService_->userExists(username, email)) {
-        LOG_WARN << "Attempt to register existing username or email: " << username << "/" << email;
-        return std::unexpected(AuthError("Username or email already exists.", 409)); // 409 Conflict
-    }
-
-    // Create user via UserService (which handles password hashing and transaction)
+    // Create user via UserService, which hashes the password and lets the
+    // UNIQUE constraints decide whether the username or email is taken
     auto createdUserOpt = userService_->createUser(username, email, plainPassword);
 
     if (!createdUserOpt) {
+        if (createdUserOpt.error().kind == UserService::CreateUserError::Kind::Conflict) {
+            LOG_WARN << "Attempt to register existing username or email: " << username << "/" << email;
+            return std::unexpected(AuthError(createdUserOpt.error().message, 409)); // 409 Conflict
+        }
         auto loc = std::source_location::current();
         LOG_ERROR << "User registration failed at " << loc.file_name() << ":" << loc.line() 
                  << " for user: " << username;
@@ -52,15 +52,9 @@ AuthService::registerUser(
 
     LOG_INFO << "User registered successfully: " << username;
     
-    // Ensure the returned model doesn't contain sensitive data
-    comfyui_plus_backend::app::models::User safeUserModel;
-    safeUserModel.setId(createdUserOpt->getId().value_or(0));
-    safeUserModel.setUsername(createdUserOpt->getUsername());
-    safeUserModel.setEmail(createdUserOpt->getEmail());
-    safeUserModel.setCreatedAt(createdUserOpt->getCreatedAt());
-    safeUserModel.setUpdatedAt(createdUserOpt->getUpdatedAt());
-    
-    return safeUserModel;
+    // dbModelToUserModel never copies the password hash, and serializers skip
+    // it at compile time, so the model is returned as-is
+    return std::move(*createdUserOpt);
 }
 
 // Legacy method implementation
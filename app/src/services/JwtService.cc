@@ -1,5 +1,7 @@
 // app/src/services/JwtService.cc
 #include "comfyui_plus_backend/services/JwtService.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
 #include <drogon/drogon.h> // For app().getCustomConfig() and LOG_ERROR
 #include <memory>          // For std::make_unique if needed (not directly here)
 
@@ -21,17 +23,11 @@ JwtService::JwtService()
         // Try to get the config directly from the app instance
         const auto &jsonConfig = drogon::app().getCustomConfig();
         
-        // Debug the raw configuration to see what we're working with
-        LOG_DEBUG << "Drogon config: " << (jsonConfig.isNull() ? "null" : jsonConfig.toStyledString());
-        
         // Use our global config if Drogon's is null
         const Json::Value& jwtConfig = jsonConfig.isNull() || !jsonConfig.isMember("jwt") 
             ? globalJwtConfig 
             : jsonConfig["jwt"];
         
-        // Debug the JWT section
-        LOG_DEBUG << "JWT config being used: " << (jwtConfig.isNull() ? "null" : jwtConfig.toStyledString());
-        
         if (jwtConfig.isNull()) {
             LOG_FATAL << "JWT configuration is null - neither from app config nor global config!";
             return;
@@ -134,6 +130,7 @@ std::optional<jwt::decoded_jwt<jwt::traits::kazuho_picojson>> JwtService::verify
         return std::nullopt;
     }
 
+    utils::Metrics::increment(utils::Metrics::Counter::JwtVerifications);
     try
     {
         auto decoded_token = jwt::decode<jwt::traits::kazuho_picojson>(tokenString);
@@ -145,6 +142,7 @@ std::optional<jwt::decoded_jwt<jwt::traits::kazuho_picojson>> JwtService::verify
     }
     catch (const std::exception &e)
     {
+        utils::Metrics::increment(utils::Metrics::Counter::JwtVerificationFailures);
         LOG_ERROR << "Error verifying JWT: " << e.what();
         return std::nullopt;
     }
@@ -0,0 +1,221 @@
+// app/src/services/UserCache.cc
+#include "comfyui_plus_backend/services/UserCache.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+extern Json::Value globalUsersConfig;
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+namespace
+{
+
+constexpr size_t kDefaultCapacity = 10000;
+
+size_t configuredCapacity()
+{
+    const auto &jsonConfig = drogon::app().getCustomConfig();
+    const Json::Value &usersConfig = jsonConfig.isNull() || !jsonConfig.isMember("users")
+        ? globalUsersConfig
+        : jsonConfig["users"];
+    if (usersConfig.isMember("cache_capacity") && usersConfig["cache_capacity"].isUInt64()) {
+        return usersConfig["cache_capacity"].asUInt64();
+    }
+    return kDefaultCapacity;
+}
+
+} // namespace
+
+UserCache& UserCache::getInstance()
+{
+    static UserCache instance;
+    return instance;
+}
+
+UserCache::UserCache()
+    : shardCapacity_(std::max<size_t>(1, configuredCapacity() / kShardCount))
+{
+    LOG_DEBUG << "UserCache holds up to " << capacity() << " users";
+}
+
+UserCache::NameShard &UserCache::shardFor(NameIndex &index, const std::string &name)
+{
+    return index[std::hash<std::string>{}(name) % kShardCount];
+}
+
+std::shared_ptr<const models::User> UserCache::lookup(int64_t userId)
+{
+    auto &shard = shardFor(userId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(userId);
+    if (it == shard.index.end()) {
+        return nullptr;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return it->second->user;
+}
+
+std::optional<models::User> UserCache::findById(int64_t userId)
+{
+    auto user = lookup(userId);
+    if (!user) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return *user;
+}
+
+std::optional<models::User> UserCache::findByName(NameIndex &index, const std::string &name, bool byEmail)
+{
+    std::optional<int64_t> userId;
+    {
+        auto &shard = shardFor(index, name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(name);
+        if (it != shard.ids.end()) {
+            userId = it->second;
+        }
+    }
+
+    std::shared_ptr<const models::User> user;
+    if (userId) {
+        user = lookup(*userId);
+    }
+    // The index may outlive a record or point at a user who has since been renamed
+    if (!user || (byEmail ? user->getEmail() : user->getUsername()) != name) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return *user;
+}
+
+std::optional<models::User> UserCache::findByUsername(const std::string &username)
+{
+    return findByName(usernames_, username, false);
+}
+
+std::optional<models::User> UserCache::findByEmail(const std::string &email)
+{
+    return findByName(emails_, email, true);
+}
+
+void UserCache::put(const models::User &user, uint64_t generation)
+{
+    if (!user.getId()) {
+        return;
+    }
+    const int64_t userId = *user.getId();
+    auto record = std::make_shared<const models::User>(user);
+
+    std::vector<std::shared_ptr<const models::User>> evicted;
+    {
+        auto &shard = shardFor(userId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // Checked under the shard lock, which invalidate() takes after bumping
+        // the generation, so a stale record can never land after its invalidation
+        if (generation != generation_.load(std::memory_order_acquire)) {
+            return;
+        }
+        auto it = shard.index.find(userId);
+        if (it != shard.index.end()) {
+            it->second->user = record;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        } else {
+            shard.entries.push_front(Entry{userId, record});
+            shard.index.emplace(userId, shard.entries.begin());
+            while (shard.entries.size() > shardCapacity_) {
+                evicted.push_back(std::move(shard.entries.back().user));
+                shard.index.erase(shard.entries.back().id);
+                shard.entries.pop_back();
+            }
+        }
+    }
+
+    // One lock at a time: name shards are never taken while holding a record shard
+    for (const auto &old : evicted) {
+        eraseName(usernames_, old->getUsername(), *old->getId());
+        eraseName(emails_, old->getEmail(), *old->getId());
+    }
+    {
+        auto &shard = shardFor(usernames_, record->getUsername());
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.ids[record->getUsername()] = userId;
+    }
+    {
+        auto &shard = shardFor(emails_, record->getEmail());
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.ids[record->getEmail()] = userId;
+    }
+}
+
+void UserCache::eraseName(NameIndex &index, const std::string &name, int64_t userId)
+{
+    auto &shard = shardFor(index, name);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.ids.find(name);
+    if (it != shard.ids.end() && it->second == userId) {
+        shard.ids.erase(it);
+    }
+}
+
+void UserCache::invalidate(int64_t userId)
+{
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    std::shared_ptr<const models::User> old;
+    {
+        auto &shard = shardFor(userId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(userId);
+        if (it == shard.index.end()) {
+            return;
+        }
+        old = std::move(it->second->user);
+        shard.entries.erase(it->second);
+        shard.index.erase(it);
+    }
+    eraseName(usernames_, old->getUsername(), userId);
+    eraseName(emails_, old->getEmail(), userId);
+}
+
+void UserCache::invalidateNames(const std::string &username, const std::string &email)
+{
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    for (auto [index, name] : {std::pair{&usernames_, &username}, std::pair{&emails_, &email}}) {
+        auto &shard = shardFor(*index, *name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.ids.erase(*name);
+    }
+}
+
+double UserCache::hitRate() const
+{
+    const uint64_t hitCount = hits();
+    const uint64_t total = hitCount + misses();
+    return total == 0 ? 0.0 : static_cast<double>(hitCount) / static_cast<double>(total);
+}
+
+size_t UserCache::size() const
+{
+    size_t total = 0;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
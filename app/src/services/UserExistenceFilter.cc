@@ -0,0 +1,73 @@
+// app/src/services/UserExistenceFilter.cc
+#include "comfyui_plus_backend/services/UserExistenceFilter.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <algorithm>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+namespace
+{
+
+// Head room so a fresh install does not reload after its first few signups
+constexpr size_t kMinimumCapacity = 100000;
+
+} // namespace
+
+UserExistenceFilter& UserExistenceFilter::getInstance()
+{
+    static UserExistenceFilter instance;
+    return instance;
+}
+
+void UserExistenceFilter::load(const std::vector<std::pair<std::string, std::string>> &users)
+{
+    auto filters = std::make_shared<Filters>(std::max(kMinimumCapacity, users.size() * 2));
+    for (const auto &[username, email] : users) {
+        filters->usernames.add(username);
+        filters->emails.add(email);
+    }
+    filters->count.store(users.size(), std::memory_order_relaxed);
+
+    LOG_INFO << "User existence filter loaded with " << users.size() << " users ("
+             << filters->usernames.bitCount() / 8 / 1024 << " KiB per index)";
+    filters_.store(std::move(filters), std::memory_order_release);
+}
+
+bool UserExistenceFilter::mightHaveUsername(std::string_view username) const
+{
+    auto filters = filters_.load(std::memory_order_acquire);
+    return !filters || filters->usernames.mightContain(username);
+}
+
+bool UserExistenceFilter::mightHaveEmail(std::string_view email) const
+{
+    auto filters = filters_.load(std::memory_order_acquire);
+    return !filters || filters->emails.mightContain(email);
+}
+
+void UserExistenceFilter::add(std::string_view username, std::string_view email)
+{
+    auto filters = filters_.load(std::memory_order_acquire);
+    if (!filters) {
+        return;
+    }
+    filters->usernames.add(username);
+    filters->emails.add(email);
+    filters->count.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool UserExistenceFilter::saturated() const
+{
+    auto filters = filters_.load(std::memory_order_acquire);
+    return filters && filters->count.load(std::memory_order_relaxed) > filters->usernames.expectedItems();
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
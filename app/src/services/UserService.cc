@@ -1,7 +1,13 @@
 #include "comfyui_plus_backend/services/UserService.h"
+#include "comfyui_plus_backend/services/UserCache.h"
+#include "comfyui_plus_backend/services/UserExistenceFilter.h"
+#include "comfyui_plus_backend/utils/Log.h"
 #include "comfyui_plus_backend/utils/PasswordUtils.h"
 #include <drogon/drogon.h>
-#include <chrono>
+#include <sqlite3.h>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace comfyui_plus_backend
 {
@@ -21,39 +27,35 @@ UserService::~UserService()
     LOG_DEBUG << "UserService destroyed";
 }
 
-std::optional<comfyui_plus_backend::app::models::User> UserService::createUser(
+std::expected<comfyui_plus_backend::app::models::User, UserService::CreateUserError> UserService::createUser(
     const std::string &username,
     const std::string &email,
     const std::string &plainPassword)
 {
     if (!dbManager_.isInitialized()) {
         LOG_ERROR << "CreateUser: Database not initialized";
-        return std::nullopt;
+        return std::unexpected(CreateUserError{CreateUserError::Kind::Internal, "Database not available."});
+    }
+
+    // Only names the existence filter cannot rule out cost a query here. A
+    // conflict caught now saves the Argon2 hash; the insert still decides.
+    if (userExists(username, email)) {
+        LOG_WARN << "CreateUser: Username or email already exists: " << username << "/" << email;
+        return std::unexpected(CreateUserError{CreateUserError::Kind::Conflict, "Username or email already exists."});
     }
 
     std::string hashedPassword = utils::PasswordUtils::hashPassword(plainPassword);
     if (hashedPassword.empty()) {
         LOG_ERROR << "CreateUser: Failed to hash password for user: " << username;
-        return std::nullopt;
+        return std::unexpected(CreateUserError{CreateUserError::Kind::Internal, "Failed to hash password."});
     }
 
-    // Get the current time as an ISO string
-    auto now = std::chrono::system_clock::now();
-    auto nowTime = std::chrono::system_clock::to_time_t(now);
-    char timeStr[100];
-    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&nowTime));
-    std::string timestamp(timeStr);
+    // Stored as epoch microseconds, the representation trantor::Date uses
+    const int64_t timestamp = trantor::Date::now().microSecondsSinceEpoch();
 
     try {
         auto& storage = dbManager_.getStorage();
 
-        // Check if user already exists
-        auto userExists = this->userExists(username, email);
-        if (userExists) {
-            LOG_WARN << "CreateUser: Username or email already exists: " << username << "/" << email;
-            return std::nullopt;
-        }
-
         // Create the database user model
         db::models::User dbUser;
         dbUser.username = username;
@@ -67,13 +69,33 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::createUser(
         
         // Set the ID in our user object
         dbUser.id = insertedId;
+
+        // The names may be indexed for a user that held them before
+        UserCache::getInstance().invalidateNames(username, email);
+        UserCache::getInstance().invalidate(insertedId);
+
+        auto& existenceFilter = UserExistenceFilter::getInstance();
+        existenceFilter.add(username, email);
+        if (existenceFilter.saturated()) {
+            loadExistenceFilter();
+        }
         
         // Convert to API model and return
-        return dbModelToUserModel(dbUser);
+        return dbModelToUserModel(std::move(dbUser));
+    }
+    catch (const std::system_error &e) {
+        // A registration racing this one took the name after the check above
+        if (e.code().category() == sqlite_orm::get_sqlite_error_category() &&
+            (e.code().value() & 0xff) == SQLITE_CONSTRAINT) {
+            LOG_WARN << "CreateUser: " << e.what() << " for " << username << "/" << email;
+            return std::unexpected(CreateUserError{CreateUserError::Kind::Conflict, "Username or email already exists."});
+        }
+        LOG_ERROR << "Error creating user " << username << ": " << e.what();
+        return std::unexpected(CreateUserError{CreateUserError::Kind::Internal, "Failed to save user."});
     }
     catch (const std::exception &e) {
         LOG_ERROR << "Error creating user " << username << ": " << e.what();
-        return std::nullopt;
+        return std::unexpected(CreateUserError{CreateUserError::Kind::Internal, "Failed to save user."});
     }
 }
 
@@ -84,6 +106,12 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserByEma
         return std::nullopt;
     }
 
+    auto& cache = UserCache::getInstance();
+    if (auto cached = cache.findByEmail(email)) {
+        return cached;
+    }
+    const uint64_t generation = cache.generation();
+
     try {
         auto& storage = dbManager_.getStorage();
         
@@ -97,8 +125,10 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserByEma
             return std::nullopt;
         }
         
-        // Convert to API model and return
-        return dbModelToUserModel(users.front());
+        // Convert to API model, cache and return
+        auto user = dbModelToUserModel(std::move(users.front()));
+        cache.put(user, generation);
+        return user;
     }
     catch (const std::exception &e) {
         LOG_ERROR << "Error getting user by email " << email << ": " << e.what();
@@ -113,6 +143,12 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserByUse
         return std::nullopt;
     }
 
+    auto& cache = UserCache::getInstance();
+    if (auto cached = cache.findByUsername(username)) {
+        return cached;
+    }
+    const uint64_t generation = cache.generation();
+
     try {
         auto& storage = dbManager_.getStorage();
         
@@ -126,8 +162,10 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserByUse
             return std::nullopt;
         }
         
-        // Convert to API model and return
-        return dbModelToUserModel(users.front());
+        // Convert to API model, cache and return
+        auto user = dbModelToUserModel(std::move(users.front()));
+        cache.put(user, generation);
+        return user;
     }
     catch (const std::exception &e) {
         LOG_ERROR << "Error getting user by username " << username << ": " << e.what();
@@ -142,6 +180,13 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserById(
         return std::nullopt;
     }
 
+    // Hot users are served without touching SQLite or parsing timestamps
+    auto& cache = UserCache::getInstance();
+    if (auto cached = cache.findById(userId)) {
+        return cached;
+    }
+    const uint64_t generation = cache.generation();
+
     try {
         auto& storage = dbManager_.getStorage();
         
@@ -152,8 +197,10 @@ std::optional<comfyui_plus_backend::app::models::User> UserService::getUserById(
             return std::nullopt;
         }
         
-        // Convert to API model and return
-        return dbModelToUserModel(userOpt.value());
+        // Convert to API model, cache and return
+        auto user = dbModelToUserModel(std::move(*userOpt));
+        cache.put(user, generation);
+        return user;
     }
     catch (const std::exception &e) {
         LOG_ERROR << "Error getting user by ID " << userId << ": " << e.what();
@@ -206,20 +253,33 @@ bool UserService::userExists(const std::string& username, const std::string& ema
         return true; // Safer to return true if we can't check
     }
 
+    // A definite miss in the filter needs no query; only possible hits are checked
+    const auto& existenceFilter = UserExistenceFilter::getInstance();
+    const bool checkUsername = existenceFilter.mightHaveUsername(username);
+    const bool checkEmail = existenceFilter.mightHaveEmail(email);
+    if (!checkUsername && !checkEmail) {
+        return false;
+    }
+
     try {
         auto& storage = dbManager_.getStorage();
         
         // First check username
-        auto usernameCount = storage.count<db::models::User>(
-            sqlite_orm::where(sqlite_orm::c(&db::models::User::username) == username)
-        );
-        
-        // If username exists, no need to check email
-        if (usernameCount > 0) {
-            return true;
+        if (checkUsername) {
+            auto usernameCount = storage.count<db::models::User>(
+                sqlite_orm::where(sqlite_orm::c(&db::models::User::username) == username)
+            );
+            
+            // If username exists, no need to check email
+            if (usernameCount > 0) {
+                return true;
+            }
         }
         
         // Check email
+        if (!checkEmail) {
+            return false;
+        }
         auto emailCount = storage.count<db::models::User>(
             sqlite_orm::where(sqlite_orm::c(&db::models::User::email) == email)
         );
@@ -232,7 +292,32 @@ bool UserService::userExists(const std::string& username, const std::string& ema
     }
 }
 
-comfyui_plus_backend::app::models::User UserService::dbModelToUserModel(const db::models::User& dbUser)
+bool UserService::loadExistenceFilter()
+{
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "loadExistenceFilter: Database not initialized";
+        return false;
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto rows = storage.select(sqlite_orm::columns(&db::models::User::username, &db::models::User::email));
+
+        std::vector<std::pair<std::string, std::string>> users;
+        users.reserve(rows.size());
+        for (auto& [username, email] : rows) {
+            users.emplace_back(std::move(username), std::move(email));
+        }
+        UserExistenceFilter::getInstance().load(users);
+        return true;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error loading the user existence filter: " << e.what();
+        return false;
+    }
+}
+
+comfyui_plus_backend::app::models::User UserService::dbModelToUserModel(db::models::User&& dbUser)
 {
     comfyui_plus_backend::app::models::User userModel;
     
@@ -241,17 +326,14 @@ comfyui_plus_backend::app::models::User UserService::dbModelToUserModel(const db
         userModel.setId(dbUser.id.value());
     }
     
-    userModel.setUsername(dbUser.username);
-    userModel.setEmail(dbUser.email);
+    userModel.setUsername(std::move(dbUser.username));
+    userModel.setEmail(std::move(dbUser.email));
     
     // Don't copy the hashed password to the API model for security
     
-    // Convert string timestamps to trantor::Date
-    trantor::Date createdDate = trantor::Date::fromDbStringLocal(dbUser.createdAt);
-    trantor::Date updatedDate = trantor::Date::fromDbStringLocal(dbUser.updatedAt);
-    
-    userModel.setCreatedAt(createdDate);
-    userModel.setUpdatedAt(updatedDate);
+    // Timestamps are stored as epoch microseconds; no parsing needed
+    userModel.setCreatedAt(trantor::Date(dbUser.createdAt));
+    userModel.setUpdatedAt(trantor::Date(dbUser.updatedAt));
     
     return userModel;
 }
@@ -0,0 +1,159 @@
+#include "comfyui_plus_backend/services/WorkflowEncodingService.h"
+#include "comfyui_plus_backend/graph/WorkflowLayout.h"
+#include "comfyui_plus_backend/utils/Compression.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/WorkflowJson.h"
+#include <drogon/drogon.h>
+#include <chrono>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+namespace
+{
+
+using DbWorkflowEncoding = db::models::WorkflowEncoding;
+
+} // namespace
+
+std::string_view WorkflowEncodingService::encodingName(Encoding encoding)
+{
+    return encoding == Encoding::Brotli ? "br" : "gzip";
+}
+
+WorkflowEncodingService::WorkflowEncodingService(std::shared_ptr<WorkflowService> workflowService,
+                                                 const utils::PoolTopology &workers)
+    : dbManager_(db::DatabaseManager::getInstance()),
+      workflowService_(std::move(workflowService)),
+      queue_(workers.threads, "WorkflowEncoder")
+{
+    utils::ThreadTopology::applyAffinity(queue_, workers, utils::ThreadTopology::active().pinThreads);
+    if (!utils::Compression::brotliAvailable()) {
+        LOG_WARN << "Built without brotli; only gzip workflow variants will be stored";
+    }
+    LOG_DEBUG << "WorkflowEncodingService constructed";
+}
+
+void WorkflowEncodingService::scheduleEncode(int64_t workflowId, int64_t ownerId)
+{
+    queue_.runTaskInQueue([this, workflowId, ownerId]() { encode(workflowId, ownerId); });
+}
+
+void WorkflowEncodingService::encode(int64_t workflowId, int64_t ownerId)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        return;
+    }
+
+    auto workflow = workflowService_->getWorkflowById(workflowId, ownerId);
+    if (!workflow) {
+        // Deleted since the write; nothing to encode
+        return;
+    }
+    const int64_t version = workflow->getVersion();
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto stored = storage.select(&DbWorkflowEncoding::version,
+                                     where(c(&DbWorkflowEncoding::workflowId) == workflowId));
+        bool current = !stored.empty();
+        for (int64_t storedVersion : stored) {
+            current = current && storedVersion >= version;
+        }
+        if (current) {
+            return;
+        }
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error reading encodings of workflow " << workflowId << ": " << e.what();
+        return;
+    }
+
+    auto merged = graph::mergeLayout(workflow->getJsonData(), workflow->getLayoutData());
+    if (!merged) {
+        LOG_ERROR << "Workflow " << workflowId << " has a corrupt stored body: " << merged.error();
+        return;
+    }
+    const std::string body = utils::WorkflowJson::documentBody(*workflow, {{"json_data", *merged}});
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<DbWorkflowEncoding> rows;
+    if (auto gzipped = utils::Compression::gzip(body)) {
+        rows.push_back({workflowId, std::string(encodingName(Encoding::Gzip)), version,
+                        std::vector<char>(gzipped->begin(), gzipped->end())});
+    }
+    if (auto brotli = utils::Compression::brotli(body)) {
+        rows.push_back({workflowId, std::string(encodingName(Encoding::Brotli)), version,
+                        std::vector<char>(brotli->begin(), brotli->end())});
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto guard = storage.transaction_guard();
+
+        // A slower job for an older version must not replace a newer variant
+        auto stored = storage.select(&DbWorkflowEncoding::version,
+                                     where(c(&DbWorkflowEncoding::workflowId) == workflowId));
+        for (int64_t storedVersion : stored) {
+            if (storedVersion > version) {
+                return;
+            }
+        }
+        // Skip if the workflow was deleted while compressing
+        if (storage.count<db::models::Workflow>(where(c(&db::models::Workflow::id) == workflowId)) == 0) {
+            return;
+        }
+        for (const auto &row : rows) {
+            storage.replace(row);
+        }
+        guard.commit();
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error storing encodings of workflow " << workflowId << ": " << e.what();
+        return;
+    }
+
+    LOG_DEBUG << "Encoded workflow " << workflowId << " v" << version << " (" << body.size()
+              << " bytes) into " << rows.size() << " variants in " << elapsed.count() << " ms";
+}
+
+std::optional<WorkflowEncodingService::EncodedBody> WorkflowEncodingService::findEncoded(
+    const comfyui_plus_backend::app::models::Workflow &metadata,
+    std::span<const Encoding> accepted)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized() || !metadata.getId()) {
+        return std::nullopt;
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        for (Encoding encoding : accepted) {
+            auto bodies = storage.select(
+                &DbWorkflowEncoding::body,
+                where(c(&DbWorkflowEncoding::workflowId) == *metadata.getId() &&
+                      c(&DbWorkflowEncoding::encoding) == std::string(encodingName(encoding)) &&
+                      c(&DbWorkflowEncoding::version) == metadata.getVersion()));
+            if (!bodies.empty()) {
+                return EncodedBody{encoding, std::string(bodies.front().begin(), bodies.front().end())};
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error reading encodings of workflow " << *metadata.getId() << ": " << e.what();
+    }
+    return std::nullopt;
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,59 @@
+#include "comfyui_plus_backend/services/WorkflowGraphService.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+WorkflowGraphService::WorkflowGraphService(std::shared_ptr<WorkflowService> workflowService,
+                                           size_t cacheCapacity)
+    : workflowService_(std::move(workflowService)),
+      cache_(cacheCapacity)
+{
+    LOG_DEBUG << "WorkflowGraphService constructed";
+}
+
+std::expected<WorkflowGraphService::VersionedAnalysis, WorkflowService::WorkflowError>
+WorkflowGraphService::getAnalysis(int64_t workflowId, int64_t userId)
+{
+    auto metadata = workflowService_->getWorkflowMetadata(workflowId, userId);
+    if (!metadata) {
+        return std::unexpected(metadata.error());
+    }
+
+    if (auto cached = cache_.get(workflowId, metadata->getVersion())) {
+        return VersionedAnalysis{metadata->getVersion(), std::move(cached)};
+    }
+
+    // Only the semantic graph is needed; the layout column is never read
+    auto workflow = workflowService_->getWorkflowById(workflowId, userId,
+                                                      WorkflowService::BodyParts::Graph);
+    if (!workflow) {
+        return std::unexpected(workflow.error());
+    }
+
+    auto parsed = graph::WorkflowGraph::parse(workflow->getJsonData());
+    if (!parsed) {
+        LOG_WARN << "Workflow " << workflowId << " has an unparseable graph: " << parsed.error();
+        return std::unexpected(WorkflowService::WorkflowError(parsed.error(), 422));
+    }
+
+    // Cache under the version of the body actually parsed, which may be newer
+    // than the metadata read above if an update landed in between
+    auto analysis = std::make_shared<const graph::GraphAnalysis>(graph::analyzeGraph(*parsed));
+    cache_.put(workflowId, workflow->getVersion(), analysis);
+    return VersionedAnalysis{workflow->getVersion(), std::move(analysis)};
+}
+
+void WorkflowGraphService::invalidate(int64_t workflowId)
+{
+    cache_.erase(workflowId);
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,79 @@
+#include "comfyui_plus_backend/services/WorkflowPromptService.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+
+extern Json::Value globalComfyUIConfig;
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+WorkflowPromptService::WorkflowPromptService(std::shared_ptr<WorkflowService> workflowService,
+                                             size_t cacheCapacity)
+    : workflowService_(std::move(workflowService)),
+      cache_(cacheCapacity)
+{
+    const auto &jsonConfig = drogon::app().getCustomConfig();
+    const Json::Value &comfyConfig = jsonConfig.isNull() || !jsonConfig.isMember("comfyui")
+        ? globalComfyUIConfig
+        : jsonConfig["comfyui"];
+
+    if (comfyConfig.isMember("object_info_path") && comfyConfig["object_info_path"].isString()) {
+        const std::string path = comfyConfig["object_info_path"].asString();
+        auto loaded = graph::NodeSchemaRegistry::loadFile(path);
+        if (loaded) {
+            schemas_ = std::move(*loaded);
+            LOG_INFO << "Loaded widget schemas for " << schemas_.size() << " node types from " << path;
+        } else {
+            LOG_WARN << "Could not load ComfyUI object_info from " << path << ": " << loaded.error();
+        }
+    } else {
+        LOG_WARN << "comfyui.object_info_path not configured; only workflows that name their "
+                    "widgets can be converted to prompts";
+    }
+
+    LOG_DEBUG << "WorkflowPromptService constructed";
+}
+
+std::expected<WorkflowPromptService::VersionedPrompt, WorkflowService::WorkflowError>
+WorkflowPromptService::getPrompt(int64_t workflowId, int64_t userId)
+{
+    auto metadata = workflowService_->getWorkflowMetadata(workflowId, userId);
+    if (!metadata) {
+        return std::unexpected(metadata.error());
+    }
+
+    if (auto cached = cache_.get(workflowId, metadata->getVersion())) {
+        return VersionedPrompt{metadata->getVersion(), std::move(cached)};
+    }
+
+    // Only the semantic graph is needed; the layout column is never read
+    auto workflow = workflowService_->getWorkflowById(workflowId, userId,
+                                                      WorkflowService::BodyParts::Graph);
+    if (!workflow) {
+        return std::unexpected(workflow.error());
+    }
+
+    auto converted = graph::PromptConverter(schemas_).convert(workflow->getJsonData());
+    if (!converted) {
+        LOG_WARN << "Workflow " << workflowId << " cannot be converted to a prompt: " << converted.error();
+        return std::unexpected(WorkflowService::WorkflowError(converted.error(), 422));
+    }
+
+    // Cache under the version of the body actually converted
+    auto prompt = std::make_shared<const std::string>(std::move(*converted));
+    cache_.put(workflowId, workflow->getVersion(), prompt);
+    return VersionedPrompt{workflow->getVersion(), std::move(prompt)};
+}
+
+void WorkflowPromptService::invalidate(int64_t workflowId)
+{
+    cache_.erase(workflowId);
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
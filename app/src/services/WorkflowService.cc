@@ -0,0 +1,467 @@
+#include "comfyui_plus_backend/services/WorkflowService.h"
+#include "comfyui_plus_backend/graph/WorkflowLayout.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <drogon/utils/Utilities.h>
+#include <optional>
+#include <tuple>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace services
+{
+
+namespace
+{
+
+using DbWorkflow = db::models::Workflow;
+
+// Every workflows column except the bodies, for listings and metadata reads
+auto summaryColumns()
+{
+    using namespace sqlite_orm;
+    return columns(&DbWorkflow::id, &DbWorkflow::userId, &DbWorkflow::name,
+                   &DbWorkflow::description, &DbWorkflow::thumbnailPath,
+                   &DbWorkflow::createdAt, &DbWorkflow::updatedAt, &DbWorkflow::isPublic,
+                   &DbWorkflow::version, &DbWorkflow::nodeCount, &DbWorkflow::contentHash);
+}
+
+template <typename Row>
+comfyui_plus_backend::app::models::Workflow summaryRowToModel(Row &&row)
+{
+    auto &&[id, userId, name, description, thumbnailPath, createdAt, updatedAt, isPublic,
+            version, nodeCount, contentHash] = row;
+
+    comfyui_plus_backend::app::models::Workflow workflow;
+    if (id.has_value()) {
+        workflow.setId(*id);
+    }
+    workflow.setUserId(userId);
+    workflow.setName(std::move(name));
+    workflow.setDescription(std::move(description));
+    workflow.setThumbnailPath(std::move(thumbnailPath));
+    workflow.setCreatedAt(trantor::Date(createdAt));
+    workflow.setUpdatedAt(trantor::Date(updatedAt));
+    workflow.setIsPublic(isPublic);
+    workflow.setVersion(version);
+    workflow.setNodeCount(nodeCount);
+    workflow.setContentHash(std::move(contentHash));
+    return workflow;
+}
+
+// Hashes each part separately so the bodies are never concatenated
+std::string computeContentHash(const std::string &graph, const std::string &layout)
+{
+    return drogon::utils::getSha256(drogon::utils::getSha256(graph.data(), graph.size()) +
+                                    drogon::utils::getSha256(layout.data(), layout.size()));
+}
+
+} // namespace
+
+WorkflowService::WorkflowService()
+    : dbManager_(db::DatabaseManager::getInstance())
+{
+    LOG_DEBUG << "WorkflowService constructed";
+}
+
+std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowService::WorkflowError>
+WorkflowService::createWorkflow(int64_t userId, const utils::WorkflowUpload &upload)
+{
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "createWorkflow: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    auto prepared = prepareNewWorkflow(userId, upload);
+    if (!prepared) {
+        return std::unexpected(prepared.error());
+    }
+    DbWorkflow &dbWorkflow = *prepared;
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        dbWorkflow.id = storage.insert(dbWorkflow);
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error creating workflow for user " << userId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to save workflow.", 500));
+    }
+
+    LOG_INFO << "Workflow " << *dbWorkflow.id << " created by user " << userId << " ("
+             << upload.summary.nodeCount << " nodes, " << dbWorkflow.jsonData.size() << " graph bytes, "
+             << dbWorkflow.layoutData.size() << " layout bytes)";
+    return dbModelToWorkflowModel(std::move(dbWorkflow));
+}
+
+std::expected<comfyui_plus_backend::app::db::models::Workflow, WorkflowService::WorkflowError>
+WorkflowService::prepareNewWorkflow(int64_t userId, const utils::WorkflowUpload &upload)
+{
+    if (!upload.name) {
+        return std::unexpected(WorkflowError("name is required.", 400));
+    }
+    if (!upload.jsonData) {
+        return std::unexpected(WorkflowError("json_data is required.", 400));
+    }
+
+    auto parts = graph::splitLayout(*upload.jsonData, upload.jsonDataCapacity);
+    if (!parts) {
+        return std::unexpected(WorkflowError(parts.error(), 400));
+    }
+
+    const int64_t timestamp = trantor::Date::now().microSecondsSinceEpoch();
+
+    DbWorkflow dbWorkflow;
+    dbWorkflow.userId = userId;
+    dbWorkflow.name = *upload.name;
+    dbWorkflow.description = upload.description.value_or("");
+    dbWorkflow.contentHash = computeContentHash(parts->graph, parts->layout);
+    dbWorkflow.jsonData = std::move(parts->graph);
+    dbWorkflow.layoutData = std::move(parts->layout);
+    dbWorkflow.createdAt = timestamp;
+    dbWorkflow.updatedAt = timestamp;
+    dbWorkflow.isPublic = upload.isPublic.value_or(false);
+    dbWorkflow.version = 1;
+    dbWorkflow.nodeCount = static_cast<int64_t>(upload.summary.nodeCount);
+    return dbWorkflow;
+}
+
+std::expected<void, WorkflowService::WorkflowError>
+WorkflowService::insertWorkflows(std::vector<DbWorkflow> &rows)
+{
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "insertWorkflows: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto guard = storage.transaction_guard();
+        for (auto &row : rows) {
+            row.id = storage.insert(row);
+        }
+        guard.commit();
+        return {};
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error inserting a batch of " << rows.size() << " workflows: " << e.what();
+        for (auto &row : rows) {
+            row.id.reset();
+        }
+        return std::unexpected(WorkflowError("Failed to save workflows.", 500));
+    }
+}
+
+std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowService::WorkflowError>
+WorkflowService::updateWorkflow(int64_t workflowId, int64_t userId, const utils::WorkflowUpload &upload)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "updateWorkflow: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    // Split before opening the transaction; it is pure CPU work
+    std::optional<graph::WorkflowParts> parts;
+    std::string contentHash;
+    if (upload.jsonData) {
+        auto split = graph::splitLayout(*upload.jsonData, upload.jsonDataCapacity);
+        if (!split) {
+            return std::unexpected(WorkflowError(split.error(), 400));
+        }
+        parts = std::move(*split);
+        contentHash = computeContentHash(parts->graph, parts->layout);
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto guard = storage.transaction_guard();
+
+        auto owners = storage.select(columns(&DbWorkflow::userId, &DbWorkflow::version),
+                                     where(c(&DbWorkflow::id) == workflowId));
+        if (owners.empty()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+        auto [ownerId, version] = owners.front();
+        if (ownerId != userId) {
+            return std::unexpected(WorkflowError("You do not own this workflow.", 403));
+        }
+
+        // Only touch the columns present in the payload; the body is never read back
+        auto changes = storage.dynamic_set();
+        if (upload.name) {
+            changes.push_back(assign(&DbWorkflow::name, *upload.name));
+        }
+        if (upload.description) {
+            changes.push_back(assign(&DbWorkflow::description, *upload.description));
+        }
+        if (upload.isPublic) {
+            changes.push_back(assign(&DbWorkflow::isPublic, *upload.isPublic));
+        }
+        if (parts) {
+            changes.push_back(assign(&DbWorkflow::jsonData, std::move(parts->graph)));
+            changes.push_back(assign(&DbWorkflow::layoutData, std::move(parts->layout)));
+            changes.push_back(assign(&DbWorkflow::contentHash, std::move(contentHash)));
+            changes.push_back(assign(&DbWorkflow::nodeCount,
+                                     static_cast<int64_t>(upload.summary.nodeCount)));
+        }
+        changes.push_back(assign(&DbWorkflow::version, version + 1));
+        changes.push_back(assign(&DbWorkflow::updatedAt, trantor::Date::now().microSecondsSinceEpoch()));
+
+        storage.update_all(changes, where(c(&DbWorkflow::id) == workflowId));
+
+        auto rows = storage.select(summaryColumns(), where(c(&DbWorkflow::id) == workflowId));
+        guard.commit();
+
+        LOG_INFO << "Workflow " << workflowId << " updated to version " << version + 1;
+        return summaryRowToModel(rows.front());
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error updating workflow " << workflowId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to update workflow.", 500));
+    }
+}
+
+std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowService::WorkflowError>
+WorkflowService::getWorkflowById(int64_t workflowId, int64_t userId, BodyParts parts)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "getWorkflowById: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+
+        // Both reads see the same snapshot, so the body matches the metadata's version
+        auto guard = storage.transaction_guard();
+
+        auto rows = storage.select(summaryColumns(), where(c(&DbWorkflow::id) == workflowId));
+
+        // Private workflows of other users are reported as missing
+        if (rows.empty()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+        auto workflow = summaryRowToModel(std::move(rows.front()));
+        if (workflow.getUserId() != userId && !workflow.getIsPublic()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+
+        switch (parts) {
+        case BodyParts::Graph: {
+            auto bodies = storage.select(&DbWorkflow::jsonData, where(c(&DbWorkflow::id) == workflowId));
+            workflow.setJsonData(std::move(bodies.front()));
+            break;
+        }
+        case BodyParts::Layout: {
+            auto bodies = storage.select(&DbWorkflow::layoutData, where(c(&DbWorkflow::id) == workflowId));
+            workflow.setLayoutData(std::move(bodies.front()));
+            break;
+        }
+        case BodyParts::Both: {
+            auto bodies = storage.select(columns(&DbWorkflow::jsonData, &DbWorkflow::layoutData),
+                                         where(c(&DbWorkflow::id) == workflowId));
+            auto &[jsonData, layoutData] = bodies.front();
+            workflow.setJsonData(std::move(jsonData));
+            workflow.setLayoutData(std::move(layoutData));
+            break;
+        }
+        }
+        guard.commit();
+
+        return workflow;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error getting workflow " << workflowId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to load workflow.", 500));
+    }
+}
+
+std::expected<comfyui_plus_backend::app::models::Workflow, WorkflowService::WorkflowError>
+WorkflowService::getWorkflowMetadata(int64_t workflowId, int64_t userId)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "getWorkflowMetadata: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto rows = storage.select(summaryColumns(), where(c(&DbWorkflow::id) == workflowId));
+        if (rows.empty()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+
+        auto workflow = summaryRowToModel(std::move(rows.front()));
+        if (workflow.getUserId() != userId && !workflow.getIsPublic()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+        return workflow;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error getting workflow metadata " << workflowId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to load workflow.", 500));
+    }
+}
+
+std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowService::WorkflowError>
+WorkflowService::listWorkflowsByUser(int64_t userId)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "listWorkflowsByUser: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto rows = storage.select(summaryColumns(),
+                                   where(c(&DbWorkflow::userId) == userId),
+                                   order_by(&DbWorkflow::id));
+
+        std::vector<comfyui_plus_backend::app::models::Workflow> workflows;
+        workflows.reserve(rows.size());
+        for (auto &row : rows) {
+            workflows.push_back(summaryRowToModel(std::move(row)));
+        }
+        return workflows;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error listing workflows for user " << userId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to list workflows.", 500));
+    }
+}
+
+std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowService::WorkflowError>
+WorkflowService::listWorkflowsPage(int64_t userId, int64_t afterId, int limit)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "listWorkflowsPage: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto rows = storage.select(summaryColumns(),
+                                   where(c(&DbWorkflow::userId) == userId and c(&DbWorkflow::id) > afterId),
+                                   order_by(&DbWorkflow::id),
+                                   sqlite_orm::limit(limit));
+
+        std::vector<comfyui_plus_backend::app::models::Workflow> workflows;
+        workflows.reserve(rows.size());
+        for (auto &row : rows) {
+            workflows.push_back(summaryRowToModel(std::move(row)));
+        }
+        return workflows;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error listing workflows for user " << userId << " after " << afterId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to list workflows.", 500));
+    }
+}
+
+std::expected<std::vector<comfyui_plus_backend::app::models::Workflow>, WorkflowService::WorkflowError>
+WorkflowService::listWorkflowBodiesPage(int64_t userId, int64_t afterId, int limit)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "listWorkflowBodiesPage: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto rows = storage.get_all<DbWorkflow>(
+            where(c(&DbWorkflow::userId) == userId and c(&DbWorkflow::id) > afterId),
+            order_by(&DbWorkflow::id),
+            sqlite_orm::limit(limit));
+
+        std::vector<comfyui_plus_backend::app::models::Workflow> workflows;
+        workflows.reserve(rows.size());
+        for (auto &row : rows) {
+            workflows.push_back(dbModelToWorkflowModel(std::move(row)));
+        }
+        return workflows;
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error reading workflow bodies for user " << userId << " after " << afterId << ": "
+                  << e.what();
+        return std::unexpected(WorkflowError("Failed to read workflows.", 500));
+    }
+}
+
+std::expected<void, WorkflowService::WorkflowError>
+WorkflowService::deleteWorkflow(int64_t workflowId, int64_t userId)
+{
+    using namespace sqlite_orm;
+
+    if (!dbManager_.isInitialized()) {
+        LOG_ERROR << "deleteWorkflow: Database not initialized";
+        return std::unexpected(WorkflowError("Database not available.", 500));
+    }
+
+    try {
+        auto& storage = dbManager_.getStorage();
+        auto guard = storage.transaction_guard();
+
+        auto owners = storage.select(&DbWorkflow::userId, where(c(&DbWorkflow::id) == workflowId));
+        if (owners.empty()) {
+            return std::unexpected(WorkflowError("Workflow not found.", 404));
+        }
+        if (owners.front() != userId) {
+            return std::unexpected(WorkflowError("You do not own this workflow.", 403));
+        }
+
+        storage.remove_all<db::models::WorkflowTag>(
+            where(c(&db::models::WorkflowTag::workflowId) == workflowId));
+        storage.remove_all<db::models::WorkflowEncoding>(
+            where(c(&db::models::WorkflowEncoding::workflowId) == workflowId));
+        storage.remove<DbWorkflow>(workflowId);
+        guard.commit();
+
+        LOG_INFO << "Workflow " << workflowId << " deleted by user " << userId;
+        return {};
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR << "Error deleting workflow " << workflowId << ": " << e.what();
+        return std::unexpected(WorkflowError("Failed to delete workflow.", 500));
+    }
+}
+
+comfyui_plus_backend::app::models::Workflow WorkflowService::dbModelToWorkflowModel(
+    db::models::Workflow &&dbWorkflow)
+{
+    comfyui_plus_backend::app::models::Workflow workflow;
+
+    if (dbWorkflow.id.has_value()) {
+        workflow.setId(dbWorkflow.id.value());
+    }
+    workflow.setUserId(dbWorkflow.userId);
+    workflow.setName(std::move(dbWorkflow.name));
+    workflow.setDescription(std::move(dbWorkflow.description));
+    workflow.setJsonData(std::move(dbWorkflow.jsonData));
+    workflow.setLayoutData(std::move(dbWorkflow.layoutData));
+    workflow.setThumbnailPath(std::move(dbWorkflow.thumbnailPath));
+    workflow.setIsPublic(dbWorkflow.isPublic);
+    workflow.setVersion(dbWorkflow.version);
+    workflow.setNodeCount(dbWorkflow.nodeCount);
+    workflow.setContentHash(std::move(dbWorkflow.contentHash));
+    workflow.setCreatedAt(trantor::Date(dbWorkflow.createdAt));
+    workflow.setUpdatedAt(trantor::Date(dbWorkflow.updatedAt));
+
+    return workflow;
+}
+
+} // namespace services
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,269 @@
+// app/src/utils/AsyncLogWriter.cc
+#include "comfyui_plus_backend/utils/AsyncLogWriter.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include <trantor/utils/Logger.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+AsyncLogWriter *activeWriter = nullptr;
+
+void writeStdout(const char *data, uint64_t length)
+{
+    std::fwrite(data, 1, length, stdout);
+}
+
+void flushStdout()
+{
+    std::fflush(stdout);
+}
+
+std::string_view nextToken(std::string_view &rest)
+{
+    size_t end = rest.find(' ');
+    std::string_view token = rest.substr(0, end);
+    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+    return token;
+}
+
+void appendField(std::string &out, std::string_view name, std::string_view value)
+{
+    if (out.back() != '{') {
+        out.push_back(',');
+    }
+    JsonWriter::appendEscaped(out, name);
+    out.push_back(':');
+    JsonWriter::appendEscaped(out, value);
+}
+
+} // namespace
+
+void AsyncLogWriter::start(size_t capacity, Format format)
+{
+    if (activeWriter) {
+        return;
+    }
+    // Never freed: a thread may still be inside the output function at exit
+    activeWriter = new AsyncLogWriter(capacity, format);
+    trantor::Logger::setOutputFunction(
+        [writer = activeWriter](const char *data, uint64_t length) { writer->push(data, length); },
+        [writer = activeWriter]() { writer->flush(); });
+}
+
+void AsyncLogWriter::stop()
+{
+    if (!activeWriter) {
+        return;
+    }
+    trantor::Logger::setOutputFunction(writeStdout, flushStdout);
+    activeWriter->stopping_.store(true, std::memory_order_release);
+    activeWriter->pending_.fetch_add(1, std::memory_order_release);
+    activeWriter->pending_.notify_one();
+    if (activeWriter->thread_.joinable()) {
+        activeWriter->thread_.join();
+    }
+}
+
+uint64_t AsyncLogWriter::dropped()
+{
+    return activeWriter ? activeWriter->dropped_.load(std::memory_order_relaxed) : 0;
+}
+
+AsyncLogWriter::AsyncLogWriter(size_t capacity, Format format)
+    : format_(format),
+      mask_(std::bit_ceil(std::max<size_t>(capacity, 64)) - 1),
+      cells_(std::make_unique<Cell[]>(mask_ + 1))
+{
+    for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    if (thread_.joinable()) {
+        stopping_.store(true, std::memory_order_release);
+        pending_.fetch_add(1, std::memory_order_release);
+        pending_.notify_one();
+        thread_.join();
+    }
+}
+
+// Bounded multi-producer queue (Vyukov): a cell's sequence says whether it
+// is free for the producer at `pos` or holds a record for the writer
+bool AsyncLogWriter::push(const char *data, size_t length)
+{
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The cell's string keeps its capacity between records, so a warm ring
+    // copies without allocating
+    cell->record.assign(data, length);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    if (pending_.fetch_add(1, std::memory_order_release) == 0) {
+        pending_.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogWriter::run()
+{
+    std::string batch;
+    batch.reserve(64 * 1024);
+    for (;;) {
+        drain(batch);
+        // Anything pushed while draining is picked up before sleeping
+        if (pending_.exchange(0, std::memory_order_acq_rel) != 0) {
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            drain(batch);
+            return;
+        }
+        pending_.wait(0, std::memory_order_acquire);
+    }
+}
+
+void AsyncLogWriter::drain(std::string &batch)
+{
+    for (;;) {
+        batch.clear();
+        size_t records = 0;
+        while (records < 1024) {
+            Cell &cell = cells_[head_ & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+                break;
+            }
+            if (format_ == Format::Json) {
+                appendJson(batch, cell.record);
+            } else {
+                batch.append(cell.record);
+            }
+            cell.record.clear();
+            cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+            ++head_;
+            ++records;
+        }
+
+        const uint64_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops_ && records == 0) {
+            std::string notice = "AsyncLogWriter: " + std::to_string(drops) + " records dropped, log queue full";
+            if (format_ == Format::Json) {
+                batch.append("{\"level\":\"WARN\",\"msg\":");
+                JsonWriter::appendEscaped(batch, notice);
+                batch.append("}\n");
+            } else {
+                batch.append(notice).push_back('\n');
+            }
+            reportedDrops_ = drops;
+        }
+
+        if (batch.empty()) {
+            return;
+        }
+        writeStdout(batch.data(), batch.size());
+        flushStdout();
+        written_.store(head_, std::memory_order_release);
+    }
+}
+
+void AsyncLogWriter::flush()
+{
+    // Called by trantor before a fatal record aborts; wait for the writer
+    const size_t target = tail_.load(std::memory_order_acquire);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (written_.load(std::memory_order_acquire) < target && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// trantor writes "YYYYMMDD HH:MM:SS.uuuuuu [UTC ]tid LEVEL [func] message - file:line\n"
+void AsyncLogWriter::appendJson(std::string &out, std::string_view line)
+{
+    static constexpr std::array<std::string_view, 6> kLevels = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+    if (!line.empty() && line.back() == '\n') {
+        line.remove_suffix(1);
+    }
+
+    std::string_view rest = line;
+    std::string_view date = nextToken(rest);
+    std::string_view time = nextToken(rest);
+    std::string_view tid = nextToken(rest);
+    if (tid == "UTC") {
+        tid = nextToken(rest);
+    }
+    while (rest.starts_with(' ')) {
+        rest.remove_prefix(1);
+    }
+    std::string_view level = nextToken(rest);
+    while (rest.starts_with(' ')) {
+        rest.remove_prefix(1);
+    }
+
+    const bool parsed = date.size() == 8 && time.find(':') != std::string_view::npos && !tid.empty() &&
+                        std::find(kLevels.begin(), kLevels.end(), level) != kLevels.end();
+    out.push_back('{');
+    if (!parsed) {
+        appendField(out, "msg", line);
+        out.append("}\n");
+        return;
+    }
+
+    std::string timestamp;
+    timestamp.reserve(date.size() + 1 + time.size());
+    timestamp.append(date).append(" ").append(time);
+    appendField(out, "ts", timestamp);
+    appendField(out, "tid", tid);
+    appendField(out, "level", level);
+
+    std::string_view source;
+    if (size_t dash = rest.rfind(" - "); dash != std::string_view::npos) {
+        source = rest.substr(dash + 3);
+        rest = rest.substr(0, dash);
+    }
+    if (rest.starts_with('[')) {
+        if (size_t close = rest.find("] "); close != std::string_view::npos) {
+            appendField(out, "func", rest.substr(1, close - 1));
+            rest.remove_prefix(close + 2);
+        }
+    }
+    appendField(out, "msg", rest);
+    if (!source.empty()) {
+        appendField(out, "src", source);
+    }
+    out.append("}\n");
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,142 @@
+// app/src/utils/BatchRequest.cc
+#include "comfyui_plus_backend/utils/BatchRequest.h"
+#include "comfyui_plus_backend/utils/ReflectJson.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include <simdjson.h>
+#include <algorithm>
+#include <cctype>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+namespace ondemand = simdjson::ondemand;
+
+std::expected<BatchItem, std::string> parseItem(ondemand::value value, size_t index)
+{
+    const std::string where = "requests[" + std::to_string(index) + "]";
+
+    ondemand::object object;
+    if (value.get_object().get(object)) {
+        return std::unexpected(where + " must be an object.");
+    }
+
+    BatchItem item;
+    for (auto fieldResult : object) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("Invalid JSON payload.");
+        }
+        ondemand::value fieldValue = field.value();
+
+        if (key == "method") {
+            std::string_view method;
+            if (fieldValue.get_string().get(method)) {
+                return std::unexpected(where + ".method must be a string.");
+            }
+            item.method.assign(method);
+            std::transform(item.method.begin(), item.method.end(), item.method.begin(),
+                           [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+        } else if (key == "path") {
+            std::string_view path;
+            if (fieldValue.get_string().get(path)) {
+                return std::unexpected(where + ".path must be a string.");
+            }
+            item.path.assign(path);
+        } else if (key == "body") {
+            ondemand::json_type type;
+            if (fieldValue.type().get(type)) {
+                return std::unexpected("Invalid JSON payload.");
+            }
+            if (type == ondemand::json_type::null) {
+                continue;
+            }
+            std::string_view raw;
+            if (fieldValue.raw_json().get(raw)) {
+                return std::unexpected("Invalid JSON payload.");
+            }
+            // The raw view includes any whitespace that followed the value
+            while (!raw.empty() && (raw.back() == ' ' || raw.back() == '\n' ||
+                                    raw.back() == '\r' || raw.back() == '\t')) {
+                raw.remove_suffix(1);
+            }
+            item.body.assign(raw);
+        }
+    }
+
+    if (item.method.empty()) {
+        return std::unexpected(where + ".method is required.");
+    }
+    if (item.path.empty() || item.path.front() != '/') {
+        return std::unexpected(where + ".path must be an absolute path.");
+    }
+    return item;
+}
+
+} // namespace
+
+std::expected<std::vector<BatchItem>, std::string> BatchRequest::parse(std::string_view body,
+                                                                      size_t maxItems)
+{
+    RequestTrace::Phase phase("parse.batch");
+    ondemand::document doc;
+    ondemand::object root;
+    if (reflect::detail::threadParser().iterate(reflect::detail::padThreadBuffer(body)).get(doc)) {
+        return std::unexpected("Invalid JSON payload.");
+    }
+    if (doc.get_object().get(root)) {
+        return std::unexpected("Request body must be a JSON object.");
+    }
+
+    std::vector<BatchItem> items;
+    bool hasRequests = false;
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("Invalid JSON payload.");
+        }
+        if (key != "requests") {
+            continue;
+        }
+
+        ondemand::array requests;
+        if (field.value().get_array().get(requests)) {
+            return std::unexpected("requests must be an array.");
+        }
+        hasRequests = true;
+        for (auto itemResult : requests) {
+            ondemand::value value;
+            if (std::move(itemResult).get(value)) {
+                return std::unexpected("Invalid JSON payload.");
+            }
+            if (items.size() == maxItems) {
+                return std::unexpected("A batch holds at most " + std::to_string(maxItems) + " requests.");
+            }
+            auto item = parseItem(value, items.size());
+            if (!item) {
+                return std::unexpected(item.error());
+            }
+            items.push_back(std::move(*item));
+        }
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("Invalid JSON payload.");
+    }
+    if (!hasRequests) {
+        return std::unexpected("requests is required.");
+    }
+    return items;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,77 @@
+// app/src/utils/BloomFilter.cc
+#include "comfyui_plus_backend/utils/BloomFilter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+uint64_t mix(uint64_t value)
+{
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(size_t expectedItems, double falsePositiveRate)
+    : expectedItems_(std::max<size_t>(expectedItems, 1))
+{
+    const double rate = std::clamp(falsePositiveRate, 1e-9, 0.5);
+    const double ln2 = std::log(2.0);
+    const double bits = std::ceil(-static_cast<double>(expectedItems_) * std::log(rate) / (ln2 * ln2));
+    wordCount_ = std::max<size_t>(1, static_cast<size_t>(bits / 64.0) + 1);
+    hashCount_ = std::clamp<size_t>(
+        static_cast<size_t>(std::lround(static_cast<double>(bitCount()) / expectedItems_ * ln2)), 1, 16);
+    words_ = std::make_unique<std::atomic<uint64_t>[]>(wordCount_);
+}
+
+std::pair<uint64_t, uint64_t> BloomFilter::hash(std::string_view item)
+{
+    // FNV-1a over the bytes, then two decorrelated finalizations
+    uint64_t state = 0xcbf29ce484222325ULL;
+    for (unsigned char ch : item) {
+        state ^= ch;
+        state *= 0x100000001b3ULL;
+    }
+    return {mix(state), mix(state ^ 0x9e3779b97f4a7c15ULL) | 1};
+}
+
+void BloomFilter::add(std::string_view item)
+{
+    const auto [h1, h2] = hash(item);
+    const uint64_t bits = bitCount();
+    for (size_t i = 0; i < hashCount_; ++i) {
+        const uint64_t bit = (h1 + i * h2) % bits;
+        words_[bit / 64].fetch_or(uint64_t{1} << (bit % 64), std::memory_order_relaxed);
+    }
+}
+
+bool BloomFilter::mightContain(std::string_view item) const
+{
+    const auto [h1, h2] = hash(item);
+    const uint64_t bits = bitCount();
+    for (size_t i = 0; i < hashCount_; ++i) {
+        const uint64_t bit = (h1 + i * h2) % bits;
+        if (!(words_[bit / 64].load(std::memory_order_relaxed) & (uint64_t{1} << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,86 @@
+// app/src/utils/Compression.cc
+#include "comfyui_plus_backend/utils/Compression.h"
+#include <zlib.h>
+#ifdef COMFYUI_PLUS_HAVE_BROTLI
+#include <brotli/encode.h>
+#endif
+#include <algorithm>
+#include <limits>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+std::optional<std::string> Compression::gzip(std::string_view input, int level)
+{
+    z_stream stream{};
+    // windowBits 15 + 16 selects the gzip wrapper instead of zlib's
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return std::nullopt;
+    }
+
+    std::string output;
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+
+    // zlib counts in uInt, so feed inputs larger than 4 GB in slices
+    const auto *next = reinterpret_cast<const Bytef *>(input.data());
+    size_t remaining = input.size();
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(std::min<size_t>(output.size(), std::numeric_limits<uInt>::max()));
+
+    int status = Z_OK;
+    while (status == Z_OK) {
+        const size_t chunk = std::min<size_t>(remaining, std::numeric_limits<uInt>::max());
+        stream.next_in = const_cast<Bytef *>(next);
+        stream.avail_in = static_cast<uInt>(chunk);
+        status = deflate(&stream, chunk == remaining ? Z_FINISH : Z_NO_FLUSH);
+        next += chunk - stream.avail_in;
+        remaining -= chunk - stream.avail_in;
+    }
+    deflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        return std::nullopt;
+    }
+    output.resize(stream.total_out);
+    return output;
+}
+
+std::optional<std::string> Compression::brotli(std::string_view input, int quality)
+{
+#ifdef COMFYUI_PLUS_HAVE_BROTLI
+    std::string output;
+    size_t encodedSize = BrotliEncoderMaxCompressedSize(input.size());
+    if (encodedSize == 0) {
+        return std::nullopt;
+    }
+    output.resize(encodedSize);
+    if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, input.size(),
+                               reinterpret_cast<const uint8_t *>(input.data()), &encodedSize,
+                               reinterpret_cast<uint8_t *>(output.data()))) {
+        return std::nullopt;
+    }
+    output.resize(encodedSize);
+    return output;
+#else
+    (void)input;
+    (void)quality;
+    return std::nullopt;
+#endif
+}
+
+bool Compression::brotliAvailable()
+{
+#ifdef COMFYUI_PLUS_HAVE_BROTLI
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
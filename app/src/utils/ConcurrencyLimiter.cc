@@ -0,0 +1,57 @@
+// app/src/utils/ConcurrencyLimiter.cc
+#include "comfyui_plus_backend/utils/ConcurrencyLimiter.h"
+#include <algorithm>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+ConcurrencyLimiter::ConcurrencyLimiter(const Settings &settings)
+    : settings_(settings),
+      limit_(std::clamp(settings.initialLimit, settings.minLimit, settings.maxLimit)),
+      exactLimit_(static_cast<double>(limit_.load()))
+{
+}
+
+bool ConcurrencyLimiter::tryAcquire()
+{
+    size_t current = inFlight_.load(std::memory_order_relaxed);
+    do {
+        if (current >= limit_.load(std::memory_order_relaxed)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!inFlight_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void ConcurrencyLimiter::release(uint64_t latencyMicros, Clock::time_point now)
+{
+    // Counts this request, so a limit that is exactly used up still grows
+    const size_t inFlight = inFlight_.fetch_sub(1, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    if (latencyMicros > settings_.targetLatencyMicros) {
+        if (now < nextDecrease_) {
+            return;
+        }
+        exactLimit_ = std::max(static_cast<double>(settings_.minLimit), exactLimit_ * settings_.backoff);
+        nextDecrease_ = now + std::chrono::microseconds(latencyMicros);
+    } else if (static_cast<double>(inFlight) * 2 >= exactLimit_) {
+        exactLimit_ = std::min(static_cast<double>(settings_.maxLimit), exactLimit_ + 1.0 / exactLimit_);
+    } else {
+        return;
+    }
+    limit_.store(static_cast<size_t>(exactLimit_), std::memory_order_relaxed);
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
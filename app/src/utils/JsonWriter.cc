@@ -0,0 +1,130 @@
+// app/src/utils/JsonWriter.cc
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include <charconv>
+#include <cmath>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view text)
+{
+    static const char *hex = "0123456789abcdef";
+
+    out.push_back('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const auto ch = static_cast<unsigned char>(text[i]);
+        if (ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        // Copy the clean run in one go, then the escape
+        out.append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (ch) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        case '\b': out.append("\\b"); break;
+        case '\f': out.append("\\f"); break;
+        default:
+            out.append("\\u00");
+            out.push_back(hex[ch >> 4]);
+            out.push_back(hex[ch & 0xF]);
+        }
+    }
+    out.append(text.data() + runStart, text.size() - runStart);
+    out.push_back('"');
+}
+
+JsonWriter& JsonWriter::key(std::string_view name)
+{
+    separate();
+    appendEscaped(buffer_, name);
+    buffer_.push_back(':');
+    needsComma_ = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text)
+{
+    separate();
+    appendEscaped(buffer_, text);
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag)
+{
+    separate();
+    buffer_.append(flag ? "true" : "false");
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int64_t number)
+{
+    separate();
+    char digits[24];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), number);
+    buffer_.append(digits, end);
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(uint64_t number)
+{
+    separate();
+    char digits[24];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), number);
+    buffer_.append(digits, end);
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number)
+{
+    if (!std::isfinite(number)) {
+        return null();
+    }
+    separate();
+    char digits[32];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), number);
+    buffer_.append(digits, end);
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    separate();
+    buffer_.append("null");
+    needsComma_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string_view json)
+{
+    separate();
+    buffer_.append(json);
+    needsComma_ = true;
+    return *this;
+}
+
+drogon::HttpResponsePtr JsonWriter::toResponse(drogon::HttpStatusCode status) &&
+{
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setStatusCode(status);
+    resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    resp->setBody(std::move(buffer_));
+    return resp;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
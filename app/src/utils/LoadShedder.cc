@@ -0,0 +1,248 @@
+// app/src/utils/LoadShedder.cc
+#include "comfyui_plus_backend/utils/LoadShedder.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <atomic>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+constexpr const char *kPermitAttribute = "concurrency_permit";
+
+// One admitted request's slot in its limiter; released once, by
+// LoadShedder::finish() or, failing that, when the last reference goes
+class Permit
+{
+public:
+    explicit Permit(ConcurrencyLimiter &limiter)
+        : limiter_(limiter), start_(ConcurrencyLimiter::Clock::now())
+    {
+    }
+
+    ~Permit() { release(); }
+
+    Permit(const Permit&) = delete;
+    Permit& operator=(const Permit&) = delete;
+
+    // Keeps the slot past finish(). The latency fed back is still the time
+    // to this call: a stream lasts as long as its client takes to read it,
+    // which says nothing about how loaded the server is.
+    void hold()
+    {
+        heldMicros_ = elapsedMicros(ConcurrencyLimiter::Clock::now());
+        held_ = true;
+    }
+
+    void finish()
+    {
+        if (!held_) {
+            release();
+        }
+    }
+
+    void release()
+    {
+        if (released_.exchange(true, std::memory_order_relaxed)) {
+            return;
+        }
+        const auto now = ConcurrencyLimiter::Clock::now();
+        limiter_.release(held_ ? heldMicros_ : elapsedMicros(now), now);
+    }
+
+private:
+    uint64_t elapsedMicros(ConcurrencyLimiter::Clock::time_point now) const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(now - start_).count();
+    }
+
+    ConcurrencyLimiter &limiter_;
+    const ConcurrencyLimiter::Clock::time_point start_;
+    std::atomic<bool> released_{false};
+    // Set on the I/O loop before the holder can hand the permit elsewhere
+    bool held_ = false;
+    uint64_t heldMicros_ = 0;
+};
+
+std::expected<ConcurrencyLimiter::Settings, std::string> classFromConfig(const Json::Value &section,
+                                                                         const std::string &name,
+                                                                         ConcurrencyLimiter::Settings settings)
+{
+    if (section.isNull()) {
+        return settings;
+    }
+    if (!section.isObject()) {
+        return std::unexpected("load_shedding." + name + " must be an object");
+    }
+
+    const std::pair<const char *, size_t *> limits[] = {{"initial_limit", &settings.initialLimit},
+                                                       {"min_limit", &settings.minLimit},
+                                                       {"max_limit", &settings.maxLimit}};
+    for (const auto &[key, value] : limits) {
+        if (!section.isMember(key)) {
+            continue;
+        }
+        if (!section[key].isUInt64() || section[key].asUInt64() == 0) {
+            return std::unexpected("load_shedding." + name + "." + key + " must be a positive integer");
+        }
+        *value = section[key].asUInt64();
+    }
+    if (settings.minLimit > settings.maxLimit) {
+        return std::unexpected("load_shedding." + name + ".min_limit must not exceed max_limit");
+    }
+
+    if (section.isMember("target_latency_ms")) {
+        const Json::Value &target = section["target_latency_ms"];
+        if (!target.isNumeric() || target.asDouble() <= 0) {
+            return std::unexpected("load_shedding." + name + ".target_latency_ms must be a number above 0");
+        }
+        settings.targetLatencyMicros = static_cast<uint64_t>(target.asDouble() * 1000.0);
+    }
+    return settings;
+}
+
+} // namespace
+
+// Off until configure(); the limiters exist so that limiter() is always valid
+LoadShedder::LoadShedder()
+{
+    Settings defaults;
+    defaults.enabled = false;
+    configure(defaults);
+}
+
+LoadShedder& LoadShedder::getInstance()
+{
+    static LoadShedder instance;
+    return instance;
+}
+
+std::expected<LoadShedder::Settings, std::string> LoadShedder::settingsFromConfig(const Json::Value &section)
+{
+    Settings settings;
+    if (section.isNull()) {
+        return settings;
+    }
+    if (!section.isObject()) {
+        return std::unexpected("load_shedding must be an object");
+    }
+
+    settings.enabled = section.get("enabled", true).asBool();
+    double backoff = settings.classes[0].backoff;
+    if (section.isMember("backoff")) {
+        if (!section["backoff"].isNumeric() || section["backoff"].asDouble() <= 0 ||
+            section["backoff"].asDouble() >= 1) {
+            return std::unexpected("load_shedding.backoff must be a number between 0 and 1");
+        }
+        backoff = section["backoff"].asDouble();
+    }
+
+    for (size_t i = 0; i < kClassCount; ++i) {
+        const std::string name(className(static_cast<RouteClass>(i)));
+        auto parsed = classFromConfig(section[name], name, settings.classes[i]);
+        if (!parsed) {
+            return std::unexpected(parsed.error());
+        }
+        settings.classes[i] = *parsed;
+        settings.classes[i].backoff = backoff;
+    }
+    return settings;
+}
+
+std::string_view LoadShedder::className(RouteClass routeClass)
+{
+    switch (routeClass) {
+    case RouteClass::Auth:
+        return "auth";
+    case RouteClass::WorkflowRead:
+        return "workflow_read";
+    case RouteClass::WorkflowWrite:
+        return "workflow_write";
+    default:
+        return "unknown";
+    }
+}
+
+std::optional<LoadShedder::RouteClass> LoadShedder::classify(drogon::HttpMethod method, std::string_view path)
+{
+    if (path.starts_with("/auth/")) {
+        return RouteClass::Auth;
+    }
+    // A batch's sub-requests may write, so the whole batch counts as one
+    if (path == "/batch") {
+        return RouteClass::WorkflowWrite;
+    }
+    if (path == "/workflows" || path.starts_with("/workflows/")) {
+        return method == drogon::Get || method == drogon::Head ? RouteClass::WorkflowRead
+                                                               : RouteClass::WorkflowWrite;
+    }
+    return std::nullopt;
+}
+
+void LoadShedder::configure(const Settings &settings)
+{
+    enabled_ = settings.enabled;
+    for (size_t i = 0; i < kClassCount; ++i) {
+        limiters_[i] = std::make_unique<ConcurrencyLimiter>(settings.classes[i]);
+    }
+}
+
+bool LoadShedder::admit(const drogon::HttpRequestPtr &req)
+{
+    if (!enabled_) {
+        return true;
+    }
+    auto routeClass = classify(req->method(), req->path());
+    if (!routeClass) {
+        return true;
+    }
+
+    auto &limiter = *limiters_[static_cast<size_t>(*routeClass)];
+    if (!limiter.tryAcquire()) {
+        LOG_DEBUG << "Shed " << req->methodString() << " " << req->path() << " at "
+                  << className(*routeClass) << " limit " << limiter.limit();
+        return false;
+    }
+    req->attributes()->insert(kPermitAttribute, std::make_shared<Permit>(limiter));
+    return true;
+}
+
+void LoadShedder::finish(const drogon::HttpRequestPtr &req)
+{
+    if (req->attributes()->find(kPermitAttribute)) {
+        req->attributes()->get<std::shared_ptr<Permit>>(kPermitAttribute)->finish();
+    }
+}
+
+std::shared_ptr<void> LoadShedder::holdPermit(const drogon::HttpRequestPtr &req)
+{
+    if (!req->attributes()->find(kPermitAttribute)) {
+        return nullptr;
+    }
+    auto permit = req->attributes()->get<std::shared_ptr<Permit>>(kPermitAttribute);
+    permit->hold();
+    return permit;
+}
+
+drogon::HttpResponsePtr LoadShedder::overloadedResponse()
+{
+    auto resp = drogon::HttpResponse::newHttpJsonResponse({{"error", "Server is overloaded; try again shortly."}});
+    resp->setStatusCode(drogon::HttpStatusCode::k503ServiceUnavailable);
+    resp->addHeader("Retry-After", "1");
+    return resp;
+}
+
+const ConcurrencyLimiter& LoadShedder::limiter(RouteClass routeClass) const
+{
+    return *limiters_[static_cast<size_t>(routeClass)];
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,279 @@
+// app/src/utils/Metrics.cc
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+constexpr size_t kCounterCount = static_cast<size_t>(Metrics::Counter::Count_);
+
+// Only the owning thread writes, so a relaxed load and store replaces a locked add
+void bump(std::atomic<uint64_t> &value, uint64_t by)
+{
+    value.store(value.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+struct RouteStats {
+    std::string method;
+    std::string route;
+    std::array<std::atomic<uint64_t>, 5> statusClasses{}; // 1xx .. 5xx
+    std::array<std::atomic<uint64_t>, Metrics::kLatencyBucketCount> buckets{};
+    std::atomic<uint64_t> latencySumMicros{0};
+};
+
+// One per thread; aligned so neighbouring blocks never share a cache line
+struct alignas(64) ThreadBlock {
+    std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+
+    // The owner looks routes up without it, since only the owner inserts;
+    // it locks to insert, and a scrape locks to read
+    std::mutex routesMutex;
+    std::unordered_map<std::string, std::unique_ptr<RouteStats>> routes;
+    std::string keyBuffer;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+ThreadBlock &localBlock()
+{
+    thread_local ThreadBlock *block = [] {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.blocks.push_back(std::make_unique<ThreadBlock>());
+        return reg.blocks.back().get();
+    }();
+    return *block;
+}
+
+size_t bucketIndex(uint64_t latencyMicros)
+{
+    size_t index = 0;
+    while (index < std::size(Metrics::kLatencyBucketsMicros) &&
+           latencyMicros > Metrics::kLatencyBucketsMicros[index]) {
+        ++index;
+    }
+    return index;
+}
+
+void appendLabelValue(std::string &out, std::string_view value)
+{
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (c == '\n') {
+            out.append("\\n");
+        } else {
+            out.push_back(c);
+        }
+    }
+}
+
+void appendSeconds(std::string &out, uint64_t value, uint64_t perSecond)
+{
+    out.append(std::to_string(value / perSecond));
+    uint64_t fraction = value % perSecond;
+    if (fraction != 0) {
+        std::string digits = std::to_string(fraction + perSecond).substr(1);
+        digits.erase(digits.find_last_not_of('0') + 1);
+        out.push_back('.');
+        out.append(digits);
+    }
+}
+
+void appendHeader(std::string &out, std::string_view name, std::string_view type, std::string_view help)
+{
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+struct RouteTotals {
+    std::array<uint64_t, 5> statusClasses{};
+    std::array<uint64_t, Metrics::kLatencyBucketCount> buckets{};
+    uint64_t latencySumMicros = 0;
+};
+
+} // namespace
+
+void Metrics::increment(Counter counter, uint64_t by)
+{
+    bump(localBlock().counters[static_cast<size_t>(counter)], by);
+}
+
+void Metrics::recordRequest(std::string_view method,
+                            std::string_view route,
+                            int statusCode,
+                            uint64_t latencyMicros)
+{
+    auto &block = localBlock();
+    block.keyBuffer.assign(method).push_back(' ');
+    block.keyBuffer.append(route);
+
+    auto it = block.routes.find(block.keyBuffer);
+    if (it == block.routes.end()) {
+        auto stats = std::make_unique<RouteStats>();
+        stats->method = method;
+        stats->route = route;
+        std::lock_guard<std::mutex> lock(block.routesMutex);
+        it = block.routes.emplace(block.keyBuffer, std::move(stats)).first;
+    }
+
+    auto &stats = *it->second;
+    const size_t statusClass = statusCode >= 100 && statusCode < 600 ? statusCode / 100 - 1 : 4;
+    bump(stats.statusClasses[statusClass], 1);
+    bump(stats.buckets[bucketIndex(latencyMicros)], 1);
+    bump(stats.latencySumMicros, latencyMicros);
+}
+
+std::string Metrics::render()
+{
+    std::array<uint64_t, kCounterCount> counters{};
+    std::map<std::pair<std::string, std::string>, RouteTotals> routes;
+
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto &block : reg.blocks) {
+            for (size_t i = 0; i < kCounterCount; ++i) {
+                counters[i] += block->counters[i].load(std::memory_order_relaxed);
+            }
+            std::lock_guard<std::mutex> routesLock(block->routesMutex);
+            for (const auto &[key, stats] : block->routes) {
+                auto &totals = routes[{stats->method, stats->route}];
+                for (size_t i = 0; i < totals.statusClasses.size(); ++i) {
+                    totals.statusClasses[i] += stats->statusClasses[i].load(std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < totals.buckets.size(); ++i) {
+                    totals.buckets[i] += stats->buckets[i].load(std::memory_order_relaxed);
+                }
+                totals.latencySumMicros += stats->latencySumMicros.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto counter = [&counters](Counter c) { return counters[static_cast<size_t>(c)]; };
+
+    std::string out;
+    out.reserve(4096 + routes.size() * 2048);
+
+    uint64_t finished = 0;
+    appendHeader(out, "comfyui_plus_http_requests_total", "counter", "HTTP requests answered, by route and status class.");
+    for (const auto &[route, totals] : routes) {
+        for (size_t i = 0; i < totals.statusClasses.size(); ++i) {
+            if (totals.statusClasses[i] == 0) {
+                continue;
+            }
+            finished += totals.statusClasses[i];
+            out.append("comfyui_plus_http_requests_total{method=\"");
+            appendLabelValue(out, route.first);
+            out.append("\",route=\"");
+            appendLabelValue(out, route.second);
+            out.append("\",status=\"").append(std::to_string(i + 1)).append("xx\"} ");
+            out.append(std::to_string(totals.statusClasses[i])).append("\n");
+        }
+    }
+
+    appendHeader(out, "comfyui_plus_http_request_duration_seconds", "histogram",
+                 "Time from receiving a request to handing its response to Drogon.");
+    for (const auto &[route, totals] : routes) {
+        std::string labels = "method=\"";
+        appendLabelValue(labels, route.first);
+        labels.append("\",route=\"");
+        appendLabelValue(labels, route.second);
+        labels.append("\"");
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < totals.buckets.size(); ++i) {
+            cumulative += totals.buckets[i];
+            out.append("comfyui_plus_http_request_duration_seconds_bucket{").append(labels).append(",le=\"");
+            if (i < std::size(kLatencyBucketsMicros)) {
+                appendSeconds(out, kLatencyBucketsMicros[i], 1'000'000);
+            } else {
+                out.append("+Inf");
+            }
+            out.append("\"} ").append(std::to_string(cumulative)).append("\n");
+        }
+        out.append("comfyui_plus_http_request_duration_seconds_sum{").append(labels).append("} ");
+        appendSeconds(out, totals.latencySumMicros, 1'000'000);
+        out.append("\ncomfyui_plus_http_request_duration_seconds_count{").append(labels).append("} ");
+        out.append(std::to_string(cumulative)).append("\n");
+    }
+
+    // Started and finished are read from different blocks at slightly different times
+    const uint64_t started = counter(Counter::RequestsStarted);
+    appendHeader(out, "comfyui_plus_http_requests_in_flight", "gauge", "Requests received and not yet answered.");
+    out.append("comfyui_plus_http_requests_in_flight ")
+        .append(std::to_string(started > finished ? started - finished : 0))
+        .append("\n");
+
+    appendHeader(out, "comfyui_plus_jwt_verifications_total", "counter", "JWT verifications, by result.");
+    const uint64_t jwtFailures = counter(Counter::JwtVerificationFailures);
+    const uint64_t jwtTotal = counter(Counter::JwtVerifications);
+    out.append("comfyui_plus_jwt_verifications_total{result=\"ok\"} ")
+        .append(std::to_string(jwtTotal > jwtFailures ? jwtTotal - jwtFailures : 0))
+        .append("\ncomfyui_plus_jwt_verifications_total{result=\"failed\"} ")
+        .append(std::to_string(jwtFailures))
+        .append("\n");
+
+    appendHeader(out, "comfyui_plus_argon2_operations_total", "counter", "Argon2 password hashes and verifications.");
+    out.append("comfyui_plus_argon2_operations_total{op=\"hash\"} ")
+        .append(std::to_string(counter(Counter::PasswordHashes)))
+        .append("\ncomfyui_plus_argon2_operations_total{op=\"verify\"} ")
+        .append(std::to_string(counter(Counter::PasswordVerifications)))
+        .append("\n");
+
+    appendHeader(out, "comfyui_plus_db_queries_total", "counter", "SQLite statements run.");
+    out.append("comfyui_plus_db_queries_total ").append(std::to_string(counter(Counter::DbQueries))).append("\n");
+    appendHeader(out, "comfyui_plus_db_query_seconds_total", "counter", "Time spent running SQLite statements.");
+    out.append("comfyui_plus_db_query_seconds_total ");
+    appendSeconds(out, counter(Counter::DbQueryNanos), 1'000'000'000);
+    out.append("\n");
+
+    appendHeader(out, "comfyui_plus_pool_tasks_total", "counter", "Tasks run by worker pools.");
+    out.append("comfyui_plus_pool_tasks_total{pool=\"db_workers\"} ")
+        .append(std::to_string(counter(Counter::DbWorkerTasks)))
+        .append("\ncomfyui_plus_pool_tasks_total{pool=\"password_hash_workers\"} ")
+        .append(std::to_string(counter(Counter::PasswordHashTasks)))
+        .append("\n");
+    appendHeader(out, "comfyui_plus_pool_wait_seconds_total", "counter", "Time tasks spent queued before a worker took them.");
+    out.append("comfyui_plus_pool_wait_seconds_total{pool=\"db_workers\"} ");
+    appendSeconds(out, counter(Counter::DbWorkerWaitNanos), 1'000'000'000);
+    out.append("\ncomfyui_plus_pool_wait_seconds_total{pool=\"password_hash_workers\"} ");
+    appendSeconds(out, counter(Counter::PasswordHashWaitNanos), 1'000'000'000);
+    out.append("\n");
+
+    appendHeader(out, "comfyui_plus_rate_limited_total", "counter", "Auth requests refused with 429, by the bucket that ran dry.");
+    out.append("comfyui_plus_rate_limited_total{key=\"ip\"} ")
+        .append(std::to_string(counter(Counter::RateLimitedByIp)))
+        .append("\ncomfyui_plus_rate_limited_total{key=\"account\"} ")
+        .append(std::to_string(counter(Counter::RateLimitedByAccount)))
+        .append("\n");
+
+    return out;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,28 @@
+// app/src/utils/PasswordHashPool.cc
+#include "comfyui_plus_backend/utils/PasswordHashPool.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+PasswordHashPool& PasswordHashPool::getInstance()
+{
+    static PasswordHashPool instance;
+    return instance;
+}
+
+PasswordHashPool::PasswordHashPool()
+    : WorkerPool("PasswordHash",
+                 ThreadTopology::active().passwordHashWorkers,
+                 Metrics::Counter::PasswordHashWaitNanos,
+                 Metrics::Counter::PasswordHashTasks,
+                 "wait.password_hash")
+{
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -1,4 +1,7 @@
 #include "comfyui_plus_backend/utils/PasswordUtils.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include "comfyui_plus_backend/utils/Metrics.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
 #include <argon2.h>       // Main Argon2 header
 #include <stdexcept>      // For std::runtime_error
 #include <vector>
@@ -28,6 +31,8 @@ std::string PasswordUtils::hashPassword(const std::string &plainPassword)
         return "";
     }
 
+    Metrics::increment(Metrics::Counter::PasswordHashes);
+    RequestTrace::Phase phase("argon2.hash");
     std::vector<uint8_t> salt(SALT_LENGTH);
     std::vector<uint8_t> hash(HASH_LENGTH);
 
@@ -72,6 +77,9 @@ bool PasswordUtils::verifyPassword(const std::string &plainPassword, const std::
         return false;
     }
 
+    Metrics::increment(Metrics::Counter::PasswordVerifications);
+    RequestTrace::Phase phase("argon2.verify");
+
     // argon2_verify expects a C-style string for the encoded hash
     int result = argon2id_verify(
         hashedPassword.c_str(),
@@ -0,0 +1,78 @@
+// app/src/utils/RateLimiter.cc
+#include "comfyui_plus_backend/utils/RateLimiter.h"
+#include <algorithm>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+RateLimiter::RateLimiter(Limit limit, size_t maxKeys)
+    : limit_(limit),
+      maxKeysPerShard_(std::max<size_t>(maxKeys / kShardCount, 1))
+{
+}
+
+double RateLimiter::refilled(const Bucket &bucket, Clock::time_point now) const
+{
+    const double elapsed = std::chrono::duration<double>(now - bucket.updated).count();
+    return std::min(limit_.burst, bucket.tokens + std::max(elapsed, 0.0) * limit_.tokensPerSecond);
+}
+
+RateLimiter::Decision RateLimiter::tryAcquire(std::string_view key, Clock::time_point now)
+{
+    // The low bits pick the shard; the map inside uses the whole hash
+    Shard &shard = shards_[KeyHash{}(key) % kShardCount];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.buckets.find(key);
+    if (it == shard.buckets.end()) {
+        if (shard.buckets.size() >= maxKeysPerShard_ && evictIdle(shard, now) == 0) {
+            return {false, 1.0 / limit_.tokensPerSecond};
+        }
+        shard.buckets.emplace(std::string(key), Bucket{limit_.burst - 1.0, now});
+        return {};
+    }
+
+    Bucket &bucket = it->second;
+    bucket.tokens = refilled(bucket, now);
+    bucket.updated = now;
+    if (bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        return {};
+    }
+    return {false, (1.0 - bucket.tokens) / limit_.tokensPerSecond};
+}
+
+size_t RateLimiter::evictIdle(Shard &shard, Clock::time_point now)
+{
+    return std::erase_if(shard.buckets, [this, now](const auto &entry) {
+        return refilled(entry.second, now) >= limit_.burst;
+    });
+}
+
+size_t RateLimiter::evictIdle(Clock::time_point now)
+{
+    size_t evicted = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        evicted += evictIdle(shard, now);
+    }
+    return evicted;
+}
+
+size_t RateLimiter::size() const
+{
+    size_t total = 0;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.buckets.size();
+    }
+    return total;
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,65 @@
+// app/src/utils/ReflectJson.cc
+#include "comfyui_plus_backend/utils/ReflectJson.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+namespace reflect
+{
+
+namespace detail
+{
+
+namespace
+{
+
+std::string &threadBuffer()
+{
+    thread_local std::string buffer;
+    return buffer;
+}
+
+} // namespace
+
+simdjson::ondemand::parser &threadParser()
+{
+    thread_local simdjson::ondemand::parser parser;
+    return parser;
+}
+
+simdjson::padded_string_view padThreadBuffer(std::string_view input)
+{
+    auto &buffer = threadBuffer();
+    buffer.reserve(input.size() + simdjson::SIMDJSON_PADDING);
+    buffer.assign(input.data(), input.size());
+    return simdjson::padded_string_view(buffer.data(), buffer.size(), buffer.capacity());
+}
+
+} // namespace detail
+
+std::string ReadError::message() const
+{
+    switch (kind) {
+    case Kind::TooLarge:
+        return "Request body exceeds " + std::to_string(limit) + " bytes.";
+    case Kind::InvalidJson:
+        return "Invalid JSON payload.";
+    case Kind::MissingField:
+        return "Missing required field: " + std::string(field) + ".";
+    case Kind::WrongType:
+        return "Invalid value for field: " + std::string(field) + ".";
+    case Kind::TooShort:
+        return std::string(field) + " must be at least " + std::to_string(limit) + " characters long.";
+    case Kind::TooLong:
+        return std::string(field) + " must be at most " + std::to_string(limit) + " characters long.";
+    }
+    return "Invalid request.";
+}
+
+} // namespace reflect
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
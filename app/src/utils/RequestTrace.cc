@@ -0,0 +1,273 @@
+// app/src/utils/RequestTrace.cc
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include "comfyui_plus_backend/utils/JsonWriter.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <utility>
+
+extern Json::Value globalTracingConfig;
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+struct TracingConfig {
+    bool enabled = true;
+    std::chrono::milliseconds slowThreshold{1000};
+    std::string otelFile;
+};
+
+const TracingConfig &config()
+{
+    static const TracingConfig instance = [] {
+        TracingConfig loaded;
+        const auto &jsonConfig = drogon::app().getCustomConfig();
+        const Json::Value &tracingConfig = jsonConfig.isNull() || !jsonConfig.isMember("tracing")
+            ? globalTracingConfig
+            : jsonConfig["tracing"];
+        if (tracingConfig.isMember("enabled") && tracingConfig["enabled"].isBool()) {
+            loaded.enabled = tracingConfig["enabled"].asBool();
+        }
+        if (tracingConfig.isMember("slow_request_ms") && tracingConfig["slow_request_ms"].isUInt()) {
+            loaded.slowThreshold = std::chrono::milliseconds(tracingConfig["slow_request_ms"].asUInt());
+        }
+        if (tracingConfig.isMember("otel_file") && tracingConfig["otel_file"].isString()) {
+            loaded.otelFile = tracingConfig["otel_file"].asString();
+        }
+        return loaded;
+    }();
+    return instance;
+}
+
+// Appends traces to the export file from its own thread, so a slow disk
+// never holds up a response
+class TraceExporter
+{
+public:
+    static TraceExporter *instance()
+    {
+        static TraceExporter *exporter = config().otelFile.empty() ? nullptr : new TraceExporter(config().otelFile);
+        return exporter;
+    }
+
+    void write(std::string &&line)
+    {
+        queue_.runTaskInQueue([this, line = std::move(line)]() {
+            out_ << line << '\n';
+            out_.flush();
+        });
+    }
+
+private:
+    explicit TraceExporter(const std::string &path)
+        : out_(path, std::ios::app)
+    {
+        if (!out_) {
+            LOG_ERROR << "Cannot open trace export file " << path;
+        }
+    }
+
+    std::ofstream out_;
+    trantor::ConcurrentTaskQueue queue_{1, "TraceExport"};
+};
+
+thread_local std::shared_ptr<RequestTrace> currentTrace;
+
+std::string randomHexId(size_t bytes)
+{
+    thread_local std::mt19937_64 generator{std::random_device{}()};
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string id;
+    id.reserve(bytes * 2);
+    while (id.size() < bytes * 2) {
+        uint64_t word = generator();
+        for (int i = 0; i < 16 && id.size() < bytes * 2; ++i, word >>= 4) {
+            id.push_back(kHex[word & 0xf]);
+        }
+    }
+    return id;
+}
+
+void appendMillis(std::string &out, RequestTrace::Clock::duration duration)
+{
+    char buffer[32];
+    const double millis = std::chrono::duration<double, std::milli>(duration).count();
+    std::snprintf(buffer, sizeof(buffer), "%.3f", millis);
+    out.append(buffer);
+}
+
+void writeStringAttribute(JsonWriter &json, std::string_view key, std::string_view value)
+{
+    json.beginObject().field("key", key).key("value").beginObject().field("stringValue", value).endObject().endObject();
+}
+
+} // namespace
+
+RequestTrace::RequestTrace()
+    : start_(Clock::now()),
+      wallStart_(std::chrono::system_clock::now())
+{
+    spans_.reserve(16);
+}
+
+void RequestTrace::record(const char *phase, Clock::time_point start, Clock::time_point end)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!finished_) {
+        spans_.push_back({phase, start, end});
+    }
+}
+
+void RequestTrace::finish(std::string_view method, std::string_view route, int statusCode)
+{
+    const auto end = Clock::now();
+    std::vector<Span> spans;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        spans.swap(spans_);
+    }
+
+    const auto &settings = config();
+    const auto total = end - start_;
+
+    if (total >= settings.slowThreshold) {
+        struct PhaseTotal {
+            std::string_view phase;
+            Clock::duration time{};
+            size_t count = 0;
+        };
+        std::vector<PhaseTotal> phases;
+        Clock::duration accounted{};
+        for (const auto &span : spans) {
+            auto it = std::find_if(phases.begin(), phases.end(),
+                                   [&](const PhaseTotal &p) { return p.phase == span.phase; });
+            if (it == phases.end()) {
+                it = phases.insert(phases.end(), PhaseTotal{span.phase});
+            }
+            it->time += span.end - span.start;
+            ++it->count;
+            accounted += span.end - span.start;
+        }
+
+        // key=value pairs, one line per request, so log tooling can split it
+        std::string line = "slow_request method=";
+        line.append(method).append(" route=").append(route);
+        line.append(" status=").append(std::to_string(statusCode)).append(" total_ms=");
+        appendMillis(line, total);
+        for (const auto &phase : phases) {
+            line.append(" ").append(phase.phase).append("_ms=");
+            appendMillis(line, phase.time);
+            line.append(" ").append(phase.phase).append("_n=").append(std::to_string(phase.count));
+        }
+        // Phases that ran in parallel can add up to more than the total
+        line.append(" other_ms=");
+        appendMillis(line, total > accounted ? total - accounted : Clock::duration::zero());
+        LOG_WARN << line;
+    }
+
+    auto *exporter = TraceExporter::instance();
+    if (!exporter) {
+        return;
+    }
+
+    auto unixNanos = [this](Clock::time_point t) {
+        auto wall = wallStart_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(t - start_);
+        return std::to_string(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wall.time_since_epoch()).count());
+    };
+
+    // One OTLP/JSON ExportTraceServiceRequest per line, as the OpenTelemetry
+    // Collector's file exporter writes and its file receiver reads
+    const std::string traceId = randomHexId(16);
+    const std::string rootId = randomHexId(8);
+    std::string name(method);
+    name.append(" ").append(route);
+
+    JsonWriter json(512 + spans.size() * 192);
+    json.beginObject().key("resourceSpans").beginArray().beginObject();
+    json.key("resource").beginObject().key("attributes").beginArray();
+    writeStringAttribute(json, "service.name", "comfyui-plus-backend");
+    json.endArray().endObject();
+    json.key("scopeSpans").beginArray().beginObject();
+    json.key("scope").beginObject().field("name", "comfyui_plus_backend").endObject();
+    json.key("spans").beginArray();
+
+    json.beginObject()
+        .field("traceId", traceId)
+        .field("spanId", rootId)
+        .field("name", name)
+        .field("kind", 2) // SERVER
+        .field("startTimeUnixNano", unixNanos(start_))
+        .field("endTimeUnixNano", unixNanos(end))
+        .key("attributes")
+        .beginArray();
+    writeStringAttribute(json, "http.request.method", method);
+    writeStringAttribute(json, "http.route", route);
+    json.beginObject()
+        .field("key", "http.response.status_code")
+        .key("value")
+        .beginObject()
+        .field("intValue", std::to_string(statusCode))
+        .endObject()
+        .endObject();
+    json.endArray().endObject();
+
+    for (const auto &span : spans) {
+        json.beginObject()
+            .field("traceId", traceId)
+            .field("spanId", randomHexId(8))
+            .field("parentSpanId", rootId)
+            .field("name", span.phase)
+            .field("kind", 1) // INTERNAL
+            .field("startTimeUnixNano", unixNanos(span.start))
+            .field("endTimeUnixNano", unixNanos(span.end))
+            .endObject();
+    }
+
+    json.endArray().endObject().endArray().endObject().endArray().endObject();
+    exporter->write(std::move(json).take());
+}
+
+bool RequestTrace::enabled()
+{
+    return config().enabled;
+}
+
+const std::shared_ptr<RequestTrace> &RequestTrace::current()
+{
+    return currentTrace;
+}
+
+void RequestTrace::setCurrent(std::shared_ptr<RequestTrace> trace)
+{
+    currentTrace = std::move(trace);
+}
+
+RequestTrace::Scope::Scope(std::shared_ptr<RequestTrace> trace)
+    : previous_(std::exchange(currentTrace, std::move(trace)))
+{
+}
+
+RequestTrace::Scope::~Scope()
+{
+    currentTrace = std::move(previous_);
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
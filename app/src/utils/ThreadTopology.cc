@@ -0,0 +1,210 @@
+// app/src/utils/ThreadTopology.cc
+#include "comfyui_plus_backend/utils/ThreadTopology.h"
+#include "comfyui_plus_backend/utils/Log.h"
+#include <drogon/drogon.h>
+#include <algorithm>
+#include <atomic>
+#include <latch>
+#include <memory>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+// Far above any sensible setting; catches typos like 80000
+constexpr unsigned kMaxThreadsPerPool = 256;
+
+std::expected<size_t, std::string> readCount(const Json::Value &section, const char *key, size_t fallback)
+{
+    if (!section.isMember(key)) {
+        return fallback;
+    }
+    const auto &value = section[key];
+    if (!value.isUInt() || value.asUInt() > kMaxThreadsPerPool) {
+        return std::unexpected("threads." + std::string(key) + " must be an integer from 0 to " +
+                               std::to_string(kMaxThreadsPerPool) + ".");
+    }
+    return value.asUInt() == 0 ? fallback : value.asUInt();
+}
+
+std::expected<std::vector<unsigned>, std::string> readCpus(const Json::Value &affinity, const char *key)
+{
+    std::vector<unsigned> cpus;
+    if (!affinity.isMember(key)) {
+        return cpus;
+    }
+    const auto &list = affinity[key];
+    const std::string name = "threads.cpu_affinity." + std::string(key);
+    if (!list.isArray()) {
+        return std::unexpected(name + " must be an array of CPU numbers.");
+    }
+    const size_t available = ThreadTopology::hardwareThreads();
+    for (const auto &cpu : list) {
+        if (!cpu.isUInt() || cpu.asUInt() >= available) {
+            return std::unexpected(name + " lists a CPU this machine does not have (0 to " +
+                                   std::to_string(available - 1) + ").");
+        }
+        cpus.push_back(cpu.asUInt());
+    }
+    return cpus;
+}
+
+ThreadTopology defaultTopology()
+{
+    const size_t cores = ThreadTopology::hardwareThreads();
+    ThreadTopology topology;
+    topology.io.threads = cores;
+    // Readers block on SQLite I/O, so a single core still gets two
+    topology.dbWorkers.threads = std::clamp<size_t>(cores, 2, 8);
+    // Each Argon2 hash holds 64 MiB; the pool size bounds that memory
+    topology.passwordHashWorkers.threads = std::clamp<size_t>(cores / 2, 1, 4);
+    // These mostly wait on the DB workers or on SQLite's single writer
+    topology.batchWorkers.threads = 2;
+    topology.importWorkers.threads = 1;
+    topology.encodeWorkers.threads = 1;
+    return topology;
+}
+
+ThreadTopology &activeTopology()
+{
+    static ThreadTopology topology = defaultTopology();
+    return topology;
+}
+
+} // namespace
+
+size_t ThreadTopology::hardwareThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::expected<ThreadTopology, std::string> ThreadTopology::fromConfig(const Json::Value &section)
+{
+    ThreadTopology topology = defaultTopology();
+    if (section.isNull()) {
+        return topology;
+    }
+    if (!section.isObject()) {
+        return std::unexpected("threads must be an object.");
+    }
+
+    struct PoolKeys {
+        const char *countKey;
+        const char *affinityKey;
+        PoolTopology ThreadTopology::*pool;
+    };
+    const PoolKeys pools[] = {{"io_threads", "io", &ThreadTopology::io},
+                              {"db_workers", "db_workers", &ThreadTopology::dbWorkers},
+                              {"password_hash_workers", "password_hash_workers", &ThreadTopology::passwordHashWorkers},
+                              {"batch_workers", "batch_workers", &ThreadTopology::batchWorkers},
+                              {"import_workers", "import_workers", &ThreadTopology::importWorkers},
+                              {"encode_workers", "encode_workers", &ThreadTopology::encodeWorkers}};
+
+    for (const auto &[countKey, affinityKey, pool] : pools) {
+        auto count = readCount(section, countKey, (topology.*pool).threads);
+        if (!count) {
+            return std::unexpected(count.error());
+        }
+        (topology.*pool).threads = *count;
+    }
+
+    if (section.isMember("pin_threads")) {
+        if (!section["pin_threads"].isBool()) {
+            return std::unexpected("threads.pin_threads must be true or false.");
+        }
+        topology.pinThreads = section["pin_threads"].asBool();
+    }
+
+    if (section.isMember("cpu_affinity")) {
+        const auto &affinity = section["cpu_affinity"];
+        if (!affinity.isObject()) {
+            return std::unexpected("threads.cpu_affinity must be an object.");
+        }
+        for (const auto &[countKey, affinityKey, pool] : pools) {
+            auto cpus = readCpus(affinity, affinityKey);
+            if (!cpus) {
+                return std::unexpected(cpus.error());
+            }
+            (topology.*pool).cpus = std::move(*cpus);
+        }
+    }
+    return topology;
+}
+
+const ThreadTopology &ThreadTopology::active()
+{
+    return activeTopology();
+}
+
+void ThreadTopology::setActive(ThreadTopology topology)
+{
+    activeTopology() = std::move(topology);
+}
+
+bool ThreadTopology::applyAffinity(const std::vector<unsigned> &cpus, size_t index, bool pin)
+{
+    if (cpus.empty()) {
+        return true;
+    }
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pin) {
+        CPU_SET(cpus[index % cpus.size()], &set);
+    } else {
+        for (unsigned cpu : cpus) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        LOG_WARN << "Could not set the CPU affinity of a worker thread";
+        return false;
+    }
+    return true;
+#else
+    (void)index;
+    (void)pin;
+    LOG_WARN << "threads.cpu_affinity is only supported on Linux; ignoring it";
+    return false;
+#endif
+}
+
+void ThreadTopology::applyAffinity(trantor::ConcurrentTaskQueue &queue, const PoolTopology &pool, bool pin)
+{
+    if (pool.cpus.empty()) {
+        return;
+    }
+    runOnEachThread(queue, pool.threads, [cpus = pool.cpus, pin](size_t index) {
+        applyAffinity(cpus, index, pin);
+    });
+}
+
+void ThreadTopology::runOnEachThread(trantor::ConcurrentTaskQueue &queue,
+                                     size_t threads,
+                                     std::function<void(size_t)> task)
+{
+    // Every task waits until all have started, so each lands on its own thread
+    auto started = std::make_shared<std::latch>(static_cast<std::ptrdiff_t>(threads));
+    auto nextIndex = std::make_shared<std::atomic<size_t>>(0);
+    for (size_t i = 0; i < threads; ++i) {
+        queue.runTaskInQueue([started, nextIndex, task]() {
+            task(nextIndex->fetch_add(1));
+            started->arrive_and_wait();
+        });
+    }
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
@@ -0,0 +1,53 @@
+// app/src/utils/WorkerPool.cc
+#include "comfyui_plus_backend/utils/WorkerPool.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include <chrono>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+WorkerPool::WorkerPool(const std::string &name,
+                       const PoolTopology &pool,
+                       Metrics::Counter waitCounter,
+                       Metrics::Counter taskCounter,
+                       const char *waitPhase)
+    : threadCount_(pool.threads),
+      waitCounter_(waitCounter),
+      taskCounter_(taskCounter),
+      waitPhase_(waitPhase),
+      queue_(threadCount_, name)
+{
+    ThreadTopology::applyAffinity(queue_, pool, ThreadTopology::active().pinThreads);
+}
+
+void WorkerPool::runTask(std::function<void()> &&task)
+{
+    // The task runs as part of the request that queued it
+    queue_.runTaskInQueue([this,
+                           task = std::move(task),
+                           queued = std::chrono::steady_clock::now(),
+                           trace = RequestTrace::current()]() {
+        RequestTrace::Scope traceScope(trace);
+        const auto started = std::chrono::steady_clock::now();
+        if (trace) {
+            trace->record(waitPhase_, queued, started);
+        }
+        auto waited = started - queued;
+        Metrics::increment(taskCounter_);
+        Metrics::increment(waitCounter_, std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+        task();
+    });
+}
+
+void WorkerPool::runOnEachWorker(std::function<void()> task)
+{
+    ThreadTopology::runOnEachThread(queue_, threadCount_, [task = std::move(task)](size_t) { task(); });
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
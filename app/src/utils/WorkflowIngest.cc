@@ -0,0 +1,259 @@
+// app/src/utils/WorkflowIngest.cc
+#include "comfyui_plus_backend/utils/WorkflowIngest.h"
+#include "comfyui_plus_backend/utils/RequestTrace.h"
+#include "comfyui_plus_backend/utils/Utf8.h"
+#include <simdjson.h>
+#include <algorithm>
+#include <unordered_set>
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+namespace
+{
+
+namespace ondemand = simdjson::ondemand;
+
+// One On-Demand parser and input buffer per thread. The parser keeps its
+// internal buffers between calls, so steady-state ingest does not allocate.
+struct IngestScratch {
+    ondemand::parser parser;
+    std::string buffer;
+};
+
+IngestScratch& threadScratch()
+{
+    thread_local IngestScratch scratch;
+    return scratch;
+}
+
+// Scratch kept per thread between uploads. One large upload grows the buffer
+// and the parser to its size; both are released when a smaller body follows,
+// so idle threads do not each pin the largest upload they ever saw.
+constexpr size_t kRetainedScratchBytes = 8 * 1024 * 1024;
+
+void trimScratch(IngestScratch& scratch, size_t nextInputSize)
+{
+    if (scratch.buffer.capacity() > kRetainedScratchBytes && nextInputSize < kRetainedScratchBytes) {
+        std::string().swap(scratch.buffer);
+        scratch.parser = ondemand::parser{};
+    }
+}
+
+// Returns a padded view of `input`, copying it into `buffer` unless it already
+// lives there (in which case the buffer's spare capacity provides the padding).
+simdjson::padded_string_view padInto(std::string& buffer, std::string_view input)
+{
+    const char* begin = buffer.data();
+    if (input.data() >= begin && input.data() + input.size() <= begin + buffer.size()) {
+        size_t offset = static_cast<size_t>(input.data() - begin);
+        return simdjson::padded_string_view(input.data(), input.size(), buffer.capacity() - offset);
+    }
+
+    buffer.reserve(input.size() + simdjson::SIMDJSON_PADDING);
+    buffer.assign(input.data(), input.size());
+    return simdjson::padded_string_view(buffer.data(), buffer.size(), buffer.capacity());
+}
+
+std::expected<WorkflowSummary, std::string> summarizeGraph(ondemand::parser& parser,
+                                                           simdjson::padded_string_view json)
+{
+    ondemand::document doc;
+    if (parser.iterate(json).get(doc)) {
+        return std::unexpected("json_data is not valid JSON.");
+    }
+
+    ondemand::object root;
+    if (doc.get_object().get(root)) {
+        return std::unexpected("json_data must be a JSON object.");
+    }
+
+    WorkflowSummary summary;
+    bool uiFormat = false;
+    size_t apiNodeCount = 0;
+    // Views point into the parser's string buffer, which stays valid for the
+    // lifetime of this document.
+    std::unordered_set<std::string_view> uiTypes;
+    std::unordered_set<std::string_view> apiTypes;
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+
+        ondemand::value value = field.value();
+        ondemand::json_type type;
+        if (value.type().get(type)) {
+            return std::unexpected("json_data is not valid JSON.");
+        }
+
+        if (key == "nodes" && type == ondemand::json_type::array) {
+            uiFormat = true;
+            ondemand::array nodes;
+            if (value.get_array().get(nodes)) {
+                return std::unexpected("json_data is not valid JSON.");
+            }
+            for (auto nodeResult : nodes) {
+                ondemand::object node;
+                if (nodeResult.get_object().get(node)) {
+                    return std::unexpected("Every entry in json_data.nodes must be an object.");
+                }
+                std::string_view nodeType;
+                if (node["type"].get_string().get(nodeType)) {
+                    return std::unexpected("Every node in json_data.nodes must have a string type.");
+                }
+                ++summary.nodeCount;
+                uiTypes.insert(nodeType);
+            }
+        } else if (key == "links" && type == ondemand::json_type::array) {
+            ondemand::array links;
+            if (value.get_array().get(links) || links.count_elements().get(summary.linkCount)) {
+                return std::unexpected("json_data is not valid JSON.");
+            }
+        } else if (!uiFormat && type == ondemand::json_type::object) {
+            // API prompt format: {"<node id>": {"class_type": ..., "inputs": {...}}}
+            ondemand::object node;
+            std::string_view classType;
+            if (!value.get_object().get(node) && !node["class_type"].get_string().get(classType)) {
+                ++apiNodeCount;
+                apiTypes.insert(classType);
+            }
+        }
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("json_data has trailing content.");
+    }
+
+    const auto& types = uiFormat ? uiTypes : apiTypes;
+    if (!uiFormat) {
+        if (apiNodeCount == 0) {
+            return std::unexpected("json_data must be a ComfyUI workflow (a nodes array or an API prompt).");
+        }
+        summary.nodeCount = apiNodeCount;
+    }
+
+    summary.nodeTypes.reserve(types.size());
+    for (auto type : types) {
+        summary.nodeTypes.emplace_back(type);
+    }
+    std::sort(summary.nodeTypes.begin(), summary.nodeTypes.end());
+    return summary;
+}
+
+} // namespace
+
+std::expected<WorkflowUpload, std::string> WorkflowIngest::parseUpload(std::string_view body,
+                                                                       bool requireJsonData)
+{
+    RequestTrace::Phase phase("parse.workflow");
+    auto& scratch = threadScratch();
+    trimScratch(scratch, body.size());
+    auto padded = padInto(scratch.buffer, body);
+
+    ondemand::document doc;
+    ondemand::object root;
+    if (scratch.parser.iterate(padded).get(doc)) {
+        return std::unexpected("Invalid JSON payload.");
+    }
+    if (doc.get_object().get(root)) {
+        return std::unexpected("Request body must be a JSON object.");
+    }
+
+    WorkflowUpload upload;
+    std::string_view rawGraph;
+    bool hasGraph = false;
+
+    for (auto fieldResult : root) {
+        ondemand::field field;
+        std::string_view key;
+        if (std::move(fieldResult).get(field) || field.unescaped_key().get(key)) {
+            return std::unexpected("Invalid JSON payload.");
+        }
+        ondemand::value value = field.value();
+
+        if (key == "name") {
+            std::string_view name;
+            if (value.get_string().get(name)) {
+                return std::unexpected("name must be a string.");
+            }
+            // Bytes bound code points from above, so short names skip the count
+            if (name.empty() || (name.size() > MAX_NAME_LENGTH && utf8Length(name) > MAX_NAME_LENGTH)) {
+                return std::unexpected("name must be between 1 and " + std::to_string(MAX_NAME_LENGTH) +
+                                       " characters.");
+            }
+            upload.name = std::string(name);
+        } else if (key == "description") {
+            std::string_view description;
+            if (value.get_string().get(description)) {
+                return std::unexpected("description must be a string.");
+            }
+            if (description.size() > MAX_DESCRIPTION_LENGTH && utf8Length(description) > MAX_DESCRIPTION_LENGTH) {
+                return std::unexpected("description must be at most " +
+                                       std::to_string(MAX_DESCRIPTION_LENGTH) + " characters.");
+            }
+            upload.description = std::string(description);
+        } else if (key == "is_public") {
+            bool isPublic = false;
+            if (value.get_bool().get(isPublic)) {
+                return std::unexpected("is_public must be a boolean.");
+            }
+            upload.isPublic = isPublic;
+        } else if (key == "json_data") {
+            ondemand::json_type type;
+            if (value.type().get(type) || type != ondemand::json_type::object) {
+                return std::unexpected("json_data must be a JSON object.");
+            }
+            // raw_json() hands back the exact bytes the client sent for this value
+            if (value.raw_json().get(rawGraph)) {
+                return std::unexpected("json_data is not valid JSON.");
+            }
+            // The raw view includes any whitespace that followed the value
+            while (!rawGraph.empty() && (rawGraph.back() == ' ' || rawGraph.back() == '\n' ||
+                                         rawGraph.back() == '\r' || rawGraph.back() == '\t')) {
+                rawGraph.remove_suffix(1);
+            }
+            hasGraph = true;
+        }
+        // Unknown fields are skipped without being materialized
+    }
+
+    if (!doc.at_end()) {
+        return std::unexpected("Invalid JSON payload.");
+    }
+
+    if (!hasGraph) {
+        if (requireJsonData) {
+            return std::unexpected("json_data is required.");
+        }
+        return upload;
+    }
+
+    // rawGraph is a slice of the scratch buffer, so it can be re-iterated in
+    // place. The name/description strings were copied above because this
+    // second pass invalidates the first document.
+    auto summary = summarizeGraph(scratch.parser, padInto(scratch.buffer, rawGraph));
+    if (!summary) {
+        return std::unexpected(summary.error());
+    }
+    upload.summary = std::move(*summary);
+    upload.jsonData = rawGraph;
+    upload.jsonDataCapacity = scratch.buffer.capacity() - static_cast<size_t>(rawGraph.data() - scratch.buffer.data());
+    return upload;
+}
+
+std::expected<WorkflowSummary, std::string> WorkflowIngest::summarize(std::string_view jsonData)
+{
+    auto& scratch = threadScratch();
+    return summarizeGraph(scratch.parser, padInto(scratch.buffer, jsonData));
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend
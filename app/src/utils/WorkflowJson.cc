@@ -0,0 +1,38 @@
+// app/src/utils/WorkflowJson.cc
+#include "comfyui_plus_backend/utils/WorkflowJson.h"
+#include "comfyui_plus_backend/utils/ReflectJson.h"
+
+namespace comfyui_plus_backend
+{
+namespace app
+{
+namespace utils
+{
+
+void WorkflowJson::writeMetadata(JsonWriter &json, const models::Workflow &workflow)
+{
+    reflect::writeMembers(json, workflow);
+}
+
+std::string WorkflowJson::documentBody(
+    const models::Workflow &workflow,
+    std::initializer_list<std::pair<std::string_view, std::string_view>> rawMembers)
+{
+    size_t size = 512;
+    for (const auto &[name, raw] : rawMembers) {
+        size += name.size() + raw.size() + 4;
+    }
+
+    JsonWriter json(size);
+    json.beginObject().key("workflow").beginObject();
+    writeMetadata(json, workflow);
+    for (const auto &[name, raw] : rawMembers) {
+        json.key(name).raw(raw);
+    }
+    json.endObject().endObject();
+    return std::move(json).take();
+}
+
+} // namespace utils
+} // namespace app
+} // namespace comfyui_plus_backend